@@ -0,0 +1,59 @@
+#pragma once
+#ifndef CLIENT_CONNECTION_H
+#define CLIENT_CONNECTION_H
+
+#include "employee_types.h"
+#include "fifo_manager.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    class ClientConnection {
+    public:
+        static constexpr size_t DEFAULT_PIPELINE_DEPTH = 32;
+
+    private:
+        struct Completion {
+            Response response;
+            std::vector<char> payload;
+        };
+
+        int32_t client_id_;
+        std::string server_path_;
+        std::string reply_path_;
+        Transport transport_;
+        std::shared_ptr<Channel> server_;
+        std::shared_ptr<Channel> replies_;
+        size_t max_in_flight_;
+        uint32_t next_request_id_;
+        std::unordered_set<uint32_t> in_flight_;
+        std::unordered_map<uint32_t, Completion> completed_;
+
+        bool receive_one(int timeout_ms);
+
+    public:
+        explicit ClientConnection(int32_t client_id, const std::string& server_path = SERVER_FIFO,
+                                  size_t max_in_flight = DEFAULT_PIPELINE_DEPTH, 
+                                  Transport transport = Transport::FIFO);
+        bool connect(int timeout_ms = 5000);
+        bool send_request(const Request& req, Response& resp, int timeout_ms = 5000);
+        bool send_request(const Request& req, const std::vector<char>& payload, Response& resp,
+                          std::vector<char>& reply_payload, int timeout_ms = 5000);
+        uint32_t submit(const Request& req, const std::vector<char>& payload = std::vector<char>(), 
+                        int timeout_ms = 5000);
+        bool wait(uint32_t request_id, Response& resp, std::vector<char>& reply_payload, int timeout_ms = 5000);
+        size_t in_flight() const { return in_flight_.size(); }
+        bool is_connected() const { return server_ && replies_; }
+        const std::string& reply_path() const { return reply_path_; }
+        Transport transport() const { return transport_; }
+        void disconnect();
+        ~ClientConnection();
+    };
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #ifndef EMPLOYEE_TYPES_H
 #define EMPLOYEE_TYPES_H
 
+#include <climits>
 #include <cstdint>
 #include <string>
 #include <cstring>
@@ -11,7 +12,13 @@ namespace EmployeeSystem {
     constexpr size_t MAX_CLIENTS = 100;
     constexpr size_t BUFFER_SIZE = 1024;
     constexpr char SERVER_FIFO[] = "/tmp/employee_server_fifo";
+    constexpr char SERVER_SOCKET[] = "/tmp/employee_server.sock";
     constexpr char CLIENT_FIFO_TEMPLATE[] = "/tmp/employee_client_%d_fifo";
+    constexpr char CLIENT_SHM_TEMPLATE[] = "/employee_client_%d_shm";
+    constexpr size_t MAX_REQUEST_FRAME = PIPE_BUF < 4096 ? PIPE_BUF : 4096;
+    static_assert(MAX_REQUEST_FRAME <= PIPE_BUF, "request frames must fit in one atomic FIFO write");
+    constexpr size_t MAX_RESPONSE_PAYLOAD = 1 << 20;
+    constexpr int32_t TOMBSTONE_ID = INT32_MIN;
 
     #pragma pack(push, 1)
     struct Employee {
@@ -38,16 +45,30 @@ namespace EmployeeSystem {
 
     enum class OperationType : uint8_t {
         READ = 'R',
+        PEEK = 'P',
         WRITE = 'W',
         UNLOCK = 'U',
-        EXIT = 'X'
+        EXIT = 'X',
+        CONNECT = 'C',
+        BATCH_READ = 'B',
+        BATCH_WRITE = 'M',
+        STATS = 'T',
+        COMPARE_AND_SET = 'V',
+        ATOMIC = 'A',
+        INSERT = 'I',
+        DELETE = 'D',
+        QUERY_NAME = 'Q',
+        SCAN = 'S',
+        AGGREGATE = 'G'
     };
 
     enum class ResponseStatus : uint8_t {
         SUCCESS = 'S',
         ERROR = 'E',
         LOCKED = 'L',
-        NOT_FOUND = 'N'
+        NOT_FOUND = 'N',
+        CONFLICT = 'C',
+        DUPLICATE = 'D'
     };
 
     struct Request {
@@ -56,9 +77,13 @@ namespace EmployeeSystem {
         OperationType operation;
         Employee employee;
         uint64_t timestamp;
+        uint32_t lock_timeout_ms;
+        uint32_t payload_length;
+        uint32_t request_id;
+        uint64_t version;
         
-        Request() : client_id(0), employee_id(0), 
-                   operation(OperationType::READ), timestamp(0) {}
+        Request() : client_id(0), employee_id(0), operation(OperationType::READ), 
+                   timestamp(0), lock_timeout_ms(0), payload_length(0), request_id(0), version(0) {}
     };
 
     struct Response {
@@ -66,8 +91,76 @@ namespace EmployeeSystem {
         ResponseStatus status;
         Employee employee;
         uint64_t timestamp;
+        uint32_t payload_length;
+        uint32_t request_id;
+        uint64_t version;
         
-        Response() : employee_id(0), status(ResponseStatus::ERROR), timestamp(0) {}
+        Response() : employee_id(0), status(ResponseStatus::ERROR), timestamp(0), 
+                    payload_length(0), request_id(0), version(0) {}
+    };
+
+    struct BatchWriteItem {
+        int32_t employee_id;
+        Employee employee;
+        
+        BatchWriteItem() : employee_id(0) {}
+    };
+
+    enum class AtomicKind : uint8_t {
+        ADD_HOURS = '+',
+        SET_NAME = 'N',
+        SET_HOURS_IF = '='
+    };
+
+    struct AtomicUpdate {
+        AtomicKind kind;
+        double hours;
+        double expected_hours;
+        char name[10];
+        
+        AtomicUpdate() : kind(AtomicKind::ADD_HOURS), hours(0.0), expected_hours(0.0) {
+            memset(name, 0, sizeof(name));
+        }
+    };
+
+    enum class NameMatch : uint8_t {
+        EXACT = 'E',
+        PREFIX = 'P'
+    };
+
+    struct NameQuery {
+        NameMatch match;
+        char name[10];
+        
+        NameQuery() : match(NameMatch::PREFIX) {
+            memset(name, 0, sizeof(name));
+        }
+    };
+
+    struct RangeQuery {
+        int32_t first_id;
+        int32_t last_id;
+        uint32_t limit;
+        
+        RangeQuery() : first_id(INT32_MIN + 1), last_id(INT32_MAX), limit(0) {}
+    };
+
+    struct AggregateResult {
+        uint64_t count;
+        double sum;
+        double min;
+        double max;
+        double avg;
+        
+        AggregateResult() : count(0), sum(0.0), min(0.0), max(0.0), avg(0.0) {}
+    };
+
+    struct BatchResult {
+        int32_t employee_id;
+        ResponseStatus status;
+        Employee employee;
+        
+        BatchResult() : employee_id(0), status(ResponseStatus::ERROR) {}
     };
     #pragma pack(pop)
 
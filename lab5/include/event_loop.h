@@ -0,0 +1,52 @@
+#pragma once
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace EmployeeSystem {
+
+    class EventLoop {
+    public:
+        enum Events : uint32_t {
+            READABLE = 1,
+            WRITABLE = 2,
+            HANGUP = 4
+        };
+
+        using Handler = std::function<void(uint32_t events)>;
+
+    private:
+        struct Registration {
+            uint32_t events;
+            std::shared_ptr<Handler> handler;
+        };
+
+        int poll_fd_;
+        int wake_read_fd_;
+        int wake_write_fd_;
+        std::mutex mutex_;
+        std::unordered_map<int, Registration> registrations_;
+
+        void drain_wakeups();
+
+    public:
+        EventLoop();
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+        bool is_valid() const;
+        bool add(int fd, uint32_t events, Handler handler);
+        bool modify(int fd, uint32_t enable, uint32_t disable = 0);
+        void remove(int fd);
+        int run_once(int timeout_ms);
+        void wakeup();
+        ~EventLoop();
+    };
+
+}
+
+#endif
@@ -3,20 +3,93 @@
 #define FIFO_MANAGER_H
 
 #include "employee_types.h"
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <sys/types.h>
+#include <vector>
 
 namespace EmployeeSystem {
 
+    enum class Transport { FIFO, SHM, SOCKET };
+
+    enum class SendResult { SENT, QUEUED, FAILED };
+
+    class Channel {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        virtual ~Channel() = default;
+        virtual bool send(const void* data, size_t size) = 0;
+        virtual bool receive(void* data, size_t size, int timeout_ms = -1) = 0;
+        virtual SendResult send_queued(const void* data, size_t size) {
+            return send(data, size) ? SendResult::SENT : SendResult::FAILED;
+        }
+        virtual SendResult flush() { return SendResult::SENT; }
+        virtual bool blocked_since(Clock::time_point& since) { (void)since; return false; }
+        virtual int fd() const { return -1; }
+        virtual void close() {}
+    };
+
+    class OutboundQueue {
+    public:
+        using Writer = std::function<ssize_t(const char* data, size_t size)>;
+
+        static constexpr size_t MAX_QUEUED_BYTES = 4 * MAX_RESPONSE_PAYLOAD;
+
+    private:
+        Writer write_;
+        std::mutex mutex_;
+        std::vector<char> buffer_;
+        size_t offset_;
+        Channel::Clock::time_point blocked_since_;
+        bool failed_;
+
+        SendResult drain_locked();
+
+    public:
+        explicit OutboundQueue(Writer write);
+        SendResult push(const void* data, size_t size);
+        SendResult flush();
+        bool blocked_since(Channel::Clock::time_point& since);
+        size_t queued();
+    };
+
+    class FIFOChannel : public Channel {
+    private:
+        int fd_;
+        std::mutex send_mutex_;
+        OutboundQueue outbound_;
+
+        ssize_t write_some(const char* data, size_t size);
+
+    public:
+        explicit FIFOChannel(int fd);
+        FIFOChannel(const FIFOChannel&) = delete;
+        FIFOChannel& operator=(const FIFOChannel&) = delete;
+        int fd() const override { return fd_; }
+        bool send(const void* data, size_t size) override;
+        SendResult send_queued(const void* data, size_t size) override { return outbound_.push(data, size); }
+        SendResult flush() override { return outbound_.flush(); }
+        bool blocked_since(Clock::time_point& since) override { return outbound_.blocked_since(since); }
+        bool receive(void* data, size_t size, int timeout_ms = -1) override;
+        ~FIFOChannel() override;
+    };
+
     class FIFOManager {
     public:
         static bool create_fifo(const std::string& path);
         static bool remove_fifo(const std::string& path);
         static std::unique_ptr<std::fstream> open_fifo(const std::string& path, 
                                                      std::ios_base::openmode mode);
+        static std::unique_ptr<FIFOChannel> open_channel(const std::string& path, int flags);
+        static std::string client_fifo_path(int32_t client_id);
+        static std::string client_shm_name(int32_t client_id);
     };
 
 } 
 
-#endif 
\ No newline at end of file
+#endif 
@@ -3,29 +3,110 @@
 #define FILE_MANAGER_H
 
 #include "employee_types.h"
-#include <fstream>
+#include "log_store.h"
+#include "name_index.h"
+#include "record_cache.h"
+#include "write_ahead_log.h"
+#include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 namespace EmployeeSystem {
 
+    enum class StorageMode { FILE_IO, MMAP, LOG };
+
+    enum class SyncPolicy { NONE, ASYNC, SYNC };
+
+    enum class CachePolicy { WRITE_THROUGH, WRITE_BACK };
+
+    enum class UpdateResult { APPLIED, CONFLICT, NOT_FOUND, DUPLICATE, FAILED };
+
+    struct FileOptions {
+        StorageMode mode = StorageMode::FILE_IO;
+        SyncPolicy sync = SyncPolicy::NONE;
+        bool wal = false;
+        size_t checkpoint_interval = 1024;
+        size_t cache_records = 0;
+        CachePolicy cache_policy = CachePolicy::WRITE_THROUGH;
+        size_t segment_records = LogStore::DEFAULT_SEGMENT_RECORDS;
+    };
+
     class FileManager {
     private:
         std::string filename_;
-        std::fstream file_;
-        std::mutex file_mutex_;
-        
+        FileOptions options_;
+        int fd_;
+        char* map_;
+        size_t map_capacity_;
+        std::shared_mutex file_mutex_;
+        std::unordered_map<int32_t, size_t> index_;
+        size_t record_count_;
+        size_t stored_count_;
+        std::unique_ptr<WriteAheadLog> wal_;
+        uint32_t epoch_;
+        std::vector<uint64_t> versions_;
+        std::vector<size_t> free_slots_;
+        NameIndex names_;
+        std::unique_ptr<RecordCache> cache_;
+        std::map<size_t, Employee> pending_writes_;
+        std::unique_ptr<LogStore> log_;
+
+        bool open_file(int flags);
+        void close_file();
+        bool is_open();
+        bool replace_file(const std::vector<Employee>& employees);
+        bool build_index();
+        void index_slot(const Employee& employee, size_t slot);
+        void reset_versions();
+        bool ensure_mapped(size_t bytes);
+        void unmap();
+        bool read_slots(size_t first, size_t count, Employee* out,
+                        const std::map<size_t, Employee>* dirty = nullptr);
+        bool write_slot(size_t slot, const Employee& employee);
+        bool read_slot(size_t slot, Employee& employee);
+        bool store_slot(size_t slot, const Employee& employee);
+        bool flush_cache();
+        bool flush_pending_writes();
+        bool replace_slot(std::unordered_map<int32_t, size_t>::iterator it, const Employee& employee, uint64_t& seq);
+        bool sync_storage();
+        bool recover_from_wal();
+        bool checkpoint_locked();
+        bool commit(uint64_t seq);
+
     public:
-        explicit FileManager(const std::string& filename);
+        explicit FileManager(const std::string& filename, const FileOptions& options = FileOptions());
         bool open();
         std::vector<Employee> read_all();
         bool write_all(const std::vector<Employee>& employees);
+        bool contains(int32_t id);
+        bool read_employee(int32_t id, Employee& employee);
+        bool read_employee(int32_t id, Employee& employee, uint64_t& version);
+        bool update_employee(int32_t id, const Employee& employee);
+        UpdateResult compare_and_update(int32_t id, uint64_t expected_version, const Employee& employee,
+                                        Employee& current, uint64_t& version);
+        UpdateResult modify_employee(int32_t id, const std::function<bool(Employee&)>& modify,
+                                     Employee& current, uint64_t& version);
+        UpdateResult insert_employee(const Employee& employee, uint64_t& version);
+        UpdateResult delete_employee(int32_t id);
+        std::vector<int32_t> find_by_name(const std::string& name, bool prefix, size_t limit);
+        bool scan(const std::function<bool(const Employee&)>& visit);
+        bool scan_range(int32_t first_id, int32_t last_id, size_t limit, std::vector<Employee>& employees);
+        bool aggregate(int32_t first_id, int32_t last_id, AggregateResult& result);
+        bool checkpoint();
+        RecordCache::Stats cache_stats();
+        LogStore::Stats log_stats();
+        size_t size();
+        StorageMode mode() const { return options_.mode; }
         Employee* find_employee(std::vector<Employee>& employees, int32_t id);
         void close();
         ~FileManager();
     };
 
-} 
+}
 
-#endif 
\ No newline at end of file
+#endif
\ No newline at end of file
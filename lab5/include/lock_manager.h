@@ -3,28 +3,143 @@
 #define LOCK_MANAGER_H
 
 #include "employee_types.h"
-#include <map>
-#include <set>
+#include "timing_wheel.h"
+#include <atomic>
+#include <vector>
+#include <memory>
 #include <mutex>
+#include <chrono>
+#include <limits>
+#include <functional>
+#include <unordered_map>
 #include <condition_variable>
 
 namespace EmployeeSystem {
 
     class LockManager {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using LockCallback = std::function<void(bool granted)>;
+
+        static constexpr size_t DEFAULT_STRIPES = 64;
+        static constexpr std::chrono::milliseconds LEASE_TICK{10};
+
+        struct LockStats {
+            uint64_t acquired = 0;
+            uint64_t contended = 0;
+            uint64_t denied = 0;
+            uint64_t timed_out = 0;
+        };
+
     private:
-        std::mutex mutex_;
-        std::map<int32_t, std::set<int32_t>> read_locks_;
-        std::map<int32_t, int32_t> write_locks_;
-        std::condition_variable cv_;
-        
+        static constexpr int32_t NO_CLIENT = std::numeric_limits<int32_t>::min();
+        static constexpr size_t INLINE_READERS = 4;
+        static constexpr size_t INITIAL_SLOTS = 16;
+        static constexpr size_t CLIENT_STRIPES = 16;
+
+        struct Waiter {
+            int32_t client_id;
+            bool exclusive;
+            Clock::time_point deadline;
+            uint64_t ticket;
+            LockCallback callback;
+        };
+
+        struct LockEntry {
+            bool occupied = false;
+            uint32_t hash = 0;
+            int32_t employee_id = 0;
+            int32_t writer = NO_CLIENT;
+            uint32_t inline_readers = 0;
+            int32_t readers[INLINE_READERS];
+            std::vector<int32_t> extra_readers;
+            std::vector<Waiter> waiters;
+
+            size_t reader_count() const { return inline_readers + extra_readers.size(); }
+            bool has_reader(int32_t client_id) const;
+            void add_reader(int32_t client_id);
+            void remove_reader(int32_t client_id);
+            bool idle() const { return writer == NO_CLIENT && reader_count() == 0 && waiters.empty(); }
+        };
+
+        struct alignas(64) Stripe {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::vector<LockEntry> slots;
+            size_t used = 0;
+            size_t async_waiters = 0;
+            std::vector<uint64_t> granted_tickets;
+            LockStats stats;
+
+            LockEntry* find(int32_t employee_id, uint32_t hash);
+            LockEntry& find_or_insert(int32_t employee_id, uint32_t hash);
+            void erase_if_idle(int32_t employee_id, uint32_t hash);
+            void grow();
+        };
+
+        struct alignas(64) ClientStripe {
+            std::mutex mutex;
+            std::unordered_map<int32_t, std::vector<int32_t>> owned;
+            std::unordered_map<int32_t, Clock::time_point> leases;
+        };
+
+        size_t stripe_bits_;
+        std::unique_ptr<Stripe[]> stripes_;
+        std::unique_ptr<ClientStripe[]> clients_;
+        std::atomic<uint64_t> next_ticket_{0};
+        std::mutex listener_mutex_;
+        std::function<void()> waiter_listener_;
+        std::atomic<std::chrono::milliseconds> lease_duration_{std::chrono::milliseconds(0)};
+        std::mutex lease_mutex_;
+        TimingWheel lease_wheel_;
+
+        static uint32_t mix(int32_t key);
+        Stripe& stripe_for(int32_t employee_id, uint32_t& hash);
+        size_t stripe_count() const { return size_t(1) << stripe_bits_; }
+
+        ClientStripe& client_stripe_for(int32_t client_id);
+        void track(int32_t client_id, int32_t employee_id);
+        void renew_lease_locked(ClientStripe& clients, int32_t client_id, Clock::time_point now);
+        void untrack_if_released(const LockEntry& entry, int32_t client_id);
+
+        static bool holds_lock(const LockEntry& entry, int32_t client_id);
+        static bool is_waiting(const LockEntry& entry, int32_t client_id);
+        static bool can_grant(const LockEntry& entry, int32_t client_id, bool exclusive);
+        bool try_acquire(LockEntry& entry, int32_t client_id, bool exclusive);
+        bool attempt(Stripe& stripe, LockEntry& entry, int32_t client_id, bool exclusive, bool will_wait);
+        static void grant_waiters(Stripe& stripe, LockEntry& entry, std::vector<LockCallback>& granted);
+        bool acquire_blocking(int32_t employee_id, int32_t client_id, bool exclusive,
+                              std::chrono::milliseconds timeout);
+        static void notify(std::vector<LockCallback>& callbacks, bool granted);
+
     public:
+        explicit LockManager(size_t stripes = DEFAULT_STRIPES);
+        LockManager(const LockManager&) = delete;
+        LockManager& operator=(const LockManager&) = delete;
+
         bool acquire_read_lock(int32_t employee_id, int32_t client_id);
         bool acquire_write_lock(int32_t employee_id, int32_t client_id);
+        bool acquire_read_lock(int32_t employee_id, int32_t client_id, std::chrono::milliseconds timeout);
+        bool acquire_write_lock(int32_t employee_id, int32_t client_id, std::chrono::milliseconds timeout);
+        void acquire_lock_async(int32_t employee_id, int32_t client_id, bool exclusive,
+                                std::chrono::milliseconds timeout, LockCallback callback);
+        size_t expire_waiters(Clock::time_point now = Clock::now());
+        bool next_waiter_deadline(Clock::time_point& deadline);
+        void set_waiter_listener(std::function<void()> listener);
         void release_read_lock(int32_t employee_id, int32_t client_id);
         void release_write_lock(int32_t employee_id, int32_t client_id);
         void release_all_locks(int32_t client_id);
+        void release_locks_if(int32_t client_id, const std::function<bool(int32_t)>& selected);
+        bool is_held_by(int32_t employee_id, int32_t client_id, bool exclusive);
+        bool is_locked_by_others(int32_t employee_id, int32_t client_id);
+        size_t owned_lock_count(int32_t client_id);
+        void set_lease_duration(std::chrono::milliseconds duration);
+        void renew_lease(int32_t client_id, Clock::time_point now = Clock::now());
+        std::vector<int32_t> expire_leases(Clock::time_point now = Clock::now());
+        size_t lease_count();
+        LockStats stats();
     };
 
-} 
+}
 
-#endif 
\ No newline at end of file
+#endif
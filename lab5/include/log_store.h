@@ -0,0 +1,106 @@
+#pragma once
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include "employee_types.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    #pragma pack(push, 1)
+    struct LogRecord {
+        uint64_t seq;
+        uint64_t slot;
+        Employee employee;
+        uint32_t checksum;
+
+        LogRecord() : seq(0), slot(0), checksum(0) {}
+    };
+    #pragma pack(pop)
+
+    class LogStore {
+    public:
+        static constexpr size_t DEFAULT_SEGMENT_RECORDS = 64 * 1024;
+
+        struct Stats {
+            size_t segments = 0;
+            size_t records = 0;
+            size_t live = 0;
+            size_t compactions = 0;
+            size_t reclaimed = 0;
+        };
+
+    private:
+        struct Segment {
+            uint32_t id;
+            int fd;
+            std::string path;
+            size_t records;
+            size_t live;
+
+            Segment(uint32_t segment_id, int segment_fd, const std::string& segment_path);
+            ~Segment();
+        };
+
+        struct Location {
+            uint32_t segment = 0;
+            uint32_t index = 0;
+
+            bool operator==(const Location& other) const {
+                return segment == other.segment && index == other.index;
+            }
+        };
+
+        std::string base_;
+        size_t segment_records_;
+        bool sync_appends_;
+        std::mutex mutex_;
+        std::mutex compaction_mutex_;
+        std::condition_variable cv_;
+        std::map<uint32_t, std::shared_ptr<Segment>> segments_;
+        std::vector<Location> locations_;
+        std::shared_ptr<Segment> active_;
+        uint64_t next_seq_;
+        uint32_t next_segment_;
+        bool open_;
+        bool stopping_;
+        bool pending_compaction_;
+        std::thread compactor_;
+        Stats stats_;
+
+        std::string segment_path(uint32_t id) const;
+        std::vector<uint32_t> list_segments() const;
+        std::shared_ptr<Segment> create_segment(uint32_t id);
+        bool load_segment(uint32_t id, std::vector<uint64_t>& seqs);
+        bool roll_locked();
+        bool compact_once();
+        void compactor_loop();
+        void stop_compactor();
+
+    public:
+        LogStore(const std::string& base, size_t segment_records = DEFAULT_SEGMENT_RECORDS,
+                 bool sync_appends = false);
+        bool open();
+        bool is_open();
+        size_t slot_count();
+        bool read(size_t slot, Employee& employee);
+        bool append(size_t slot, const Employee& employee);
+        bool reset(const std::vector<Employee>& employees);
+        bool sync();
+        bool compact();
+        Stats stats();
+        void close();
+        ~LogStore();
+
+        static uint32_t checksum(const LogRecord& record);
+    };
+
+}
+
+#endif
@@ -2,11 +2,16 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <chrono>
 #include <iomanip>
 
+#ifndef EMPLOYEE_LOG_MIN_LEVEL
+#define EMPLOYEE_LOG_MIN_LEVEL 0
+#endif
+
 namespace EmployeeSystem {
 
     class Logger {
@@ -18,11 +23,43 @@ namespace EmployeeSystem {
         static void info(const std::string& message);
         static void warn(const std::string& message);
         static void error(const std::string& message);
+        static void set_async(bool enabled);
+        static bool is_async();
+        static void flush();
+        static void set_output(std::ostream* out);
+        static size_t dropped();
+        static void set_level(Level level);
+        static Level level();
+        static bool parse_level(const std::string& name, Level& level);
+        
+        static constexpr bool compiled(Level level) {
+            return static_cast<int>(level) >= EMPLOYEE_LOG_MIN_LEVEL;
+        }
+        
+        static bool enabled(Level level) {
+            return compiled(level) && static_cast<int>(level) >= threshold_.load(std::memory_order_relaxed);
+        }
+        
+        static constexpr size_t ASYNC_QUEUE_CAPACITY = 8192;
 
     private:
+        static inline std::atomic<int> threshold_{0};
+        
         static const char* levelToString(Level level);
     };
 
 } 
 
+#define EMPLOYEE_LOG(level, ...) \
+    do { \
+        if (::EmployeeSystem::Logger::enabled(level)) { \
+            ::EmployeeSystem::Logger::log(level, (__VA_ARGS__)); \
+        } \
+    } while (0)
+
+#define EMPLOYEE_LOG_DEBUG(...) EMPLOYEE_LOG(::EmployeeSystem::Logger::Level::DEBUG, __VA_ARGS__)
+#define EMPLOYEE_LOG_INFO(...) EMPLOYEE_LOG(::EmployeeSystem::Logger::Level::INFO, __VA_ARGS__)
+#define EMPLOYEE_LOG_WARN(...) EMPLOYEE_LOG(::EmployeeSystem::Logger::Level::WARN, __VA_ARGS__)
+#define EMPLOYEE_LOG_ERROR(...) EMPLOYEE_LOG(::EmployeeSystem::Logger::Level::ERROR, __VA_ARGS__)
+
 #endif 
\ No newline at end of file
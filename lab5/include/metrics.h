@@ -0,0 +1,79 @@
+#pragma once
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "employee_types.h"
+#include "lock_manager.h"
+#include "record_cache.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace EmployeeSystem {
+
+    class LatencyHistogram {
+    public:
+        static constexpr size_t SUB_BUCKET_BITS = 3;
+        static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+        static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets_;
+        std::atomic<uint64_t> count_;
+        std::atomic<uint64_t> sum_;
+        std::atomic<uint64_t> max_;
+
+    public:
+        LatencyHistogram();
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        static size_t bucket_for(uint64_t micros);
+        static uint64_t bucket_upper_bound(size_t index);
+
+        void record(uint64_t micros);
+        void record(std::chrono::steady_clock::duration elapsed);
+        uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+        double mean() const;
+        uint64_t percentile(double fraction) const;
+        void reset();
+    };
+
+    enum class Phase { QUEUE_WAIT, LOCK_WAIT, IO, TOTAL };
+
+    class ServerMetrics {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t PHASES = 4;
+        static constexpr OperationType TRACKED[] = {
+            OperationType::READ, OperationType::PEEK, OperationType::WRITE, OperationType::UNLOCK,
+            OperationType::EXIT, OperationType::BATCH_READ, OperationType::BATCH_WRITE, OperationType::COMPARE_AND_SET,
+            OperationType::ATOMIC, OperationType::INSERT, OperationType::DELETE, OperationType::QUERY_NAME,
+            OperationType::SCAN, OperationType::AGGREGATE
+        };
+        static constexpr size_t OPERATIONS = sizeof(TRACKED) / sizeof(TRACKED[0]);
+
+    private:
+        std::array<std::array<LatencyHistogram, PHASES>, OPERATIONS> histograms_;
+
+        static int index_of(OperationType operation);
+
+    public:
+        static const char* operation_name(OperationType operation);
+        static const char* phase_name(Phase phase);
+
+        void record(OperationType operation, Phase phase, Clock::duration elapsed);
+        const LatencyHistogram* histogram(OperationType operation, Phase phase) const;
+        std::string report(const LockManager::LockStats& locks,
+                           const RecordCache::Stats& cache = RecordCache::Stats()) const;
+        bool dump(const std::string& path, const LockManager::LockStats& locks,
+                  const RecordCache::Stats& cache = RecordCache::Stats()) const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace EmployeeSystem {
+
+    template <typename T>
+    class MpscQueue {
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> tail_;
+        alignas(64) size_t head_;
+
+    public:
+        explicit MpscQueue(size_t capacity) : tail_(0), head_(0) {
+            size_t rounded = 2;
+            while (rounded < capacity) {
+                rounded <<= 1;
+            }
+            slots_.reset(new Slot[rounded]);
+            mask_ = rounded - 1;
+            for (size_t i = 0; i < rounded; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        bool try_push(T&& value) {
+            size_t pos = tail_.load(std::memory_order_relaxed);
+            while (true) {
+                Slot& slot = slots_[pos & mask_];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        slot.value = std::move(value);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool try_pop(T& value) {
+            Slot& slot = slots_[head_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+                return false;
+            }
+            value = std::move(slot.value);
+            slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+            ++head_;
+            return true;
+        }
+
+        bool empty() const {
+            return slots_[head_ & mask_].sequence.load(std::memory_order_acquire) != head_ + 1;
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+    };
+
+}
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include "employee_types.h"
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    class NameIndex {
+    private:
+        std::set<std::pair<std::string, int32_t>> entries_;
+        std::unordered_map<int32_t, std::string> names_;
+
+    public:
+        static std::string key(const char* name);
+        void put(int32_t id, const char* name);
+        void erase(int32_t id);
+        void clear();
+        std::vector<int32_t> find(const std::string& name, bool prefix, size_t limit) const;
+        size_t size() const { return names_.size(); }
+    };
+
+}
+
+#endif
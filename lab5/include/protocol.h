@@ -0,0 +1,50 @@
+#pragma once
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "employee_types.h"
+#include <vector>
+
+namespace EmployeeSystem {
+
+    constexpr size_t MAX_REQUEST_PAYLOAD = MAX_REQUEST_FRAME - sizeof(Request);
+    constexpr size_t MAX_BATCH_READ = MAX_REQUEST_PAYLOAD / sizeof(int32_t);
+    constexpr size_t MAX_BATCH_WRITE = MAX_REQUEST_PAYLOAD / sizeof(BatchWriteItem);
+    constexpr size_t MAX_ATOMIC_UPDATES = MAX_REQUEST_PAYLOAD / sizeof(AtomicUpdate);
+    constexpr size_t MAX_NAME_MATCHES = MAX_RESPONSE_PAYLOAD / sizeof(int32_t);
+    constexpr size_t MAX_SCAN_RECORDS = MAX_RESPONSE_PAYLOAD / sizeof(Employee);
+
+    bool encode_request(const Request& header, const void* payload, size_t payload_size, 
+                        std::vector<char>& frame);
+    void encode_response(const Response& header, const void* payload, size_t payload_size, 
+                         std::vector<char>& frame);
+
+    template <typename T>
+    bool decode_items(const std::vector<char>& payload, std::vector<T>& items) {
+        if (payload.size() % sizeof(T) != 0) {
+            return false;
+        }
+        items.resize(payload.size() / sizeof(T));
+        if (!items.empty()) {
+            memcpy(items.data(), payload.data(), payload.size());
+        }
+        return true;
+    }
+
+    class RequestReader {
+    private:
+        std::vector<char> buffer_;
+        size_t offset_;
+        size_t dropped_;
+
+    public:
+        RequestReader();
+        void append(const char* data, size_t size);
+        bool next(Request& header, std::vector<char>& payload);
+        size_t buffered() const { return buffer_.size() - offset_; }
+        size_t dropped() const { return dropped_; }
+    };
+
+}
+
+#endif
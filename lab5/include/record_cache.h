@@ -0,0 +1,63 @@
+#pragma once
+#ifndef RECORD_CACHE_H
+#define RECORD_CACHE_H
+
+#include "employee_types.h"
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace EmployeeSystem {
+
+    class RecordCache {
+    public:
+        using WriteBack = std::function<bool(size_t slot, const Employee& employee)>;
+
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint64_t write_backs = 0;
+            size_t size = 0;
+            size_t dirty = 0;
+            size_t capacity = 0;
+        };
+
+    private:
+        struct Entry {
+            size_t slot;
+            Employee employee;
+            bool dirty;
+        };
+
+        size_t capacity_;
+        WriteBack write_back_;
+        std::mutex mutex_;
+        std::list<Entry> lru_;
+        std::unordered_map<size_t, std::list<Entry>::iterator> entries_;
+        Stats stats_;
+
+        bool evict_locked();
+        void evict_clean_locked();
+        bool write_back_locked(Entry& entry);
+
+    public:
+        RecordCache(size_t capacity, WriteBack write_back);
+        RecordCache(const RecordCache&) = delete;
+        RecordCache& operator=(const RecordCache&) = delete;
+
+        bool lookup(size_t slot, Employee& employee);
+        bool fill(size_t slot, const Employee& employee);
+        bool put(size_t slot, const Employee& employee, bool dirty);
+        bool flush();
+        std::map<size_t, Employee> dirty_entries();
+        void clear();
+        Stats stats();
+        size_t capacity() const { return capacity_; }
+    };
+
+}
+
+#endif
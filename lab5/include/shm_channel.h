@@ -0,0 +1,102 @@
+#pragma once
+#ifndef SHM_CHANNEL_H
+#define SHM_CHANNEL_H
+
+#include "fifo_manager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+
+namespace EmployeeSystem {
+
+    struct RingState {
+        alignas(64) std::atomic<uint64_t> head;
+        std::atomic<uint32_t> data_seq;
+        std::atomic<uint32_t> readers_waiting;
+        alignas(64) std::atomic<uint64_t> tail;
+        std::atomic<uint32_t> space_seq;
+        std::atomic<uint32_t> writers_waiting;
+        alignas(64) std::atomic<uint32_t> closed;
+
+        RingState() : head(0), data_seq(0), readers_waiting(0),
+                      tail(0), space_seq(0), writers_waiting(0), closed(0) {}
+    };
+
+    class ShmRing {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        RingState* state_;
+        char* data_;
+        size_t capacity_;
+        int data_bell_;
+        int space_bell_;
+
+        bool wait(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting, bool for_data,
+                  bool bounded, Clock::time_point deadline, const std::atomic<bool>* interrupt);
+
+    public:
+        ShmRing() : state_(nullptr), data_(nullptr), capacity_(0), data_bell_(-1), space_bell_(-1) {}
+        ShmRing(RingState* state, char* data, size_t capacity, int data_bell = -1, int space_bell = -1)
+            : state_(state), data_(data), capacity_(capacity), data_bell_(data_bell), space_bell_(space_bell) {}
+        bool write(const void* data, size_t size, int timeout_ms = -1);
+        ssize_t write_some(const void* data, size_t size);
+        bool read(void* data, size_t size, int timeout_ms = -1, const std::atomic<bool>* interrupt = nullptr);
+        void wake_reader();
+        size_t available() const;
+        size_t capacity() const { return capacity_; }
+        void close();
+        bool closed() const;
+    };
+
+    class ShmChannel : public Channel {
+    private:
+        struct SegmentHeader;
+
+        static constexpr int DOORBELLS = 4;
+
+        std::string name_;
+        void* base_;
+        size_t length_;
+        bool owner_;
+        SegmentHeader* header_;
+        int bells_[DOORBELLS];
+        ShmRing tx_;
+        ShmRing rx_;
+        std::mutex send_mutex_;
+        OutboundQueue outbound_;
+        std::atomic<bool> flush_pending_;
+
+        ShmChannel(const std::string& name, void* base, size_t length, bool owner, const int* bells);
+        static bool open_doorbells(const std::string& name, bool create, int* bells);
+        static void remove_doorbells(const std::string& name);
+        ssize_t write_some(const char* data, size_t size);
+
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+        static constexpr int SEND_TIMEOUT_MS = 5000;
+
+        static std::unique_ptr<ShmChannel> create(const std::string& name, size_t capacity = DEFAULT_CAPACITY);
+        static std::unique_ptr<ShmChannel> attach(const std::string& name);
+
+        ShmChannel(const ShmChannel&) = delete;
+        ShmChannel& operator=(const ShmChannel&) = delete;
+        bool send(const void* data, size_t size) override;
+        SendResult send_queued(const void* data, size_t size) override;
+        SendResult flush() override;
+        bool blocked_since(Clock::time_point& since) override { return outbound_.blocked_since(since); }
+        bool receive(void* data, size_t size, int timeout_ms = -1) override;
+        void close() override;
+        bool closed() const { return rx_.closed(); }
+        bool peer_alive() const;
+        const std::string& name() const { return name_; }
+        ~ShmChannel() override;
+    };
+
+}
+
+#endif
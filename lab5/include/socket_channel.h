@@ -0,0 +1,64 @@
+#pragma once
+#ifndef SOCKET_CHANNEL_H
+#define SOCKET_CHANNEL_H
+
+#include "fifo_manager.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    class SocketChannel : public Channel {
+    private:
+        int fd_;
+        std::mutex send_mutex_;
+        std::vector<char> pending_;
+        size_t pending_offset_;
+        OutboundQueue outbound_;
+
+        bool fill(int timeout_ms);
+        ssize_t write_some(const char* data, size_t size);
+
+    public:
+        static constexpr size_t MAX_PACKET = 32 * 1024;
+
+        explicit SocketChannel(int fd);
+        static std::unique_ptr<SocketChannel> connect(const std::string& path);
+
+        SocketChannel(const SocketChannel&) = delete;
+        SocketChannel& operator=(const SocketChannel&) = delete;
+        int fd() const override { return fd_; }
+        bool send(const void* data, size_t size) override;
+        SendResult send_queued(const void* data, size_t size) override { return outbound_.push(data, size); }
+        SendResult flush() override { return outbound_.flush(); }
+        bool blocked_since(Clock::time_point& since) override { return outbound_.blocked_since(since); }
+        bool receive(void* data, size_t size, int timeout_ms = -1) override;
+        ssize_t receive_packet(char* data, size_t size);
+        void close() override;
+        ~SocketChannel() override;
+    };
+
+    class SocketListener {
+    private:
+        int fd_;
+        std::string path_;
+
+        SocketListener(int fd, const std::string& path);
+
+    public:
+        static std::unique_ptr<SocketListener> listen(const std::string& path, int backlog = MAX_CLIENTS);
+
+        SocketListener(const SocketListener&) = delete;
+        SocketListener& operator=(const SocketListener&) = delete;
+        int fd() const { return fd_; }
+        const std::string& path() const { return path_; }
+        std::unique_ptr<SocketChannel> accept();
+        ~SocketListener();
+    };
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    class TimingWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        static constexpr size_t LEVELS = 4;
+        static constexpr size_t SLOT_BITS = 6;
+        static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+
+        struct Timer {
+            int32_t key;
+            uint64_t expiry_tick;
+        };
+
+        std::chrono::milliseconds tick_;
+        Clock::time_point origin_;
+        uint64_t current_tick_;
+        size_t size_;
+        std::vector<Timer> slots_[LEVELS][SLOTS];
+
+        uint64_t tick_for(Clock::time_point time) const;
+        void insert(const Timer& timer);
+        void cascade(size_t level, std::vector<int32_t>& expired);
+
+    public:
+        explicit TimingWheel(std::chrono::milliseconds tick, Clock::time_point origin = Clock::now());
+        void schedule(int32_t key, Clock::time_point deadline);
+        void advance(Clock::time_point now, std::vector<int32_t>& expired);
+        size_t size() const { return size_; }
+        std::chrono::milliseconds tick() const { return tick_; }
+    };
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    class WorkerPool {
+    public:
+        using Task = std::function<void()>;
+
+    private:
+        struct Worker {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<Task> tasks;
+            bool stopping = false;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::atomic<size_t> next_shard_{0};
+
+        static void worker_loop(Worker& worker);
+
+    public:
+        explicit WorkerPool(size_t num_workers);
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        size_t size() const { return workers_.size(); }
+        size_t shard_for(int32_t key) const;
+        void submit(int32_t key, Task task);
+        void submit_to(size_t shard, Task task);
+        void submit_any(Task task);
+        void stop();
+        ~WorkerPool();
+    };
+
+}
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace EmployeeSystem {
+
+    enum class KeyDistribution { UNIFORM, ZIPFIAN };
+
+    enum class WorkloadOp { READ, WRITE, LOCK };
+
+    class KeyChooser {
+    private:
+        std::mt19937_64 rng_;
+        size_t keys_;
+        KeyDistribution distribution_;
+        double theta_;
+        double zetan_;
+        double alpha_;
+        double eta_;
+        double half_pow_theta_;
+
+        static double zeta(size_t n, double theta);
+        double uniform01();
+
+    public:
+        static constexpr double DEFAULT_THETA = 0.99;
+
+        KeyChooser(size_t keys, KeyDistribution distribution, double theta = DEFAULT_THETA, uint64_t seed = 1);
+        int32_t next();
+        size_t keys() const { return keys_; }
+    };
+
+    struct OperationMix {
+        unsigned read = 80;
+        unsigned write = 15;
+        unsigned lock = 5;
+
+        bool parse(const std::string& spec);
+        WorkloadOp pick(std::mt19937_64& rng) const;
+        static const char* name(WorkloadOp op);
+    };
+
+    bool parse_distribution(const std::string& name, KeyDistribution& distribution);
+
+}
+
+#endif
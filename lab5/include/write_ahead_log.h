@@ -0,0 +1,56 @@
+#pragma once
+#ifndef WRITE_AHEAD_LOG_H
+#define WRITE_AHEAD_LOG_H
+
+#include "employee_types.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EmployeeSystem {
+
+    #pragma pack(push, 1)
+    struct WalRecord {
+        uint64_t slot;
+        Employee employee;
+        uint32_t checksum;
+
+        WalRecord() : slot(0), checksum(0) {}
+    };
+    #pragma pack(pop)
+
+    class WriteAheadLog {
+    private:
+        std::string path_;
+        int fd_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<WalRecord> pending_;
+        uint64_t appended_seq_;
+        uint64_t durable_seq_;
+        size_t logged_records_;
+        size_t sync_count_;
+        bool flushing_;
+        bool failed_;
+
+    public:
+        explicit WriteAheadLog(const std::string& path);
+        bool open();
+        uint64_t append(uint64_t slot, const Employee& employee);
+        bool sync(uint64_t seq);
+        bool flush();
+        size_t replay(const std::function<bool(uint64_t, const Employee&)>& apply);
+        bool reset();
+        size_t logged_records();
+        size_t sync_count();
+        void close();
+        ~WriteAheadLog();
+
+        static uint32_t checksum(const WalRecord& record);
+    };
+
+}
+
+#endif
\ No newline at end of file
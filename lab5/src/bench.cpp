@@ -0,0 +1,473 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "employee_types.h"
+#include "client_connection.h"
+#include "metrics.h"
+#include "workload.h"
+
+namespace EmployeeSystem {
+
+    enum class WriteMode { LOCKED, CAS, ATOMIC };
+
+    struct BenchOptions {
+        size_t clients = 4;
+        size_t operations = 10000;
+        double duration = 0;
+        size_t keys = 1000;
+        OperationMix mix;
+        KeyDistribution distribution = KeyDistribution::UNIFORM;
+        double theta = KeyChooser::DEFAULT_THETA;
+        Transport transport = Transport::FIFO;
+        std::string server_binary;
+        std::vector<std::string> server_args;
+        int32_t first_client_id = 1;
+        uint64_t seed = 42;
+        WriteMode writes = WriteMode::LOCKED;
+    };
+
+    enum Outcome : uint8_t { OK, BUSY, FAILED };
+
+    #pragma pack(push, 1)
+    struct Sample {
+        uint8_t op;
+        uint8_t outcome;
+        uint32_t micros;
+    };
+
+    struct ClientSummary {
+        int64_t started_ns;
+        int64_t finished_ns;
+        uint64_t samples;
+    };
+    #pragma pack(pop)
+
+    using BenchClock = std::chrono::steady_clock;
+
+    namespace {
+
+        bool write_all(int fd, const void* data, size_t size) {
+            const char* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+                ssize_t n = ::write(fd, ptr, size);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool read_all(int fd, void* data, size_t size) {
+            char* ptr = static_cast<char*>(data);
+            while (size > 0) {
+                ssize_t n = ::read(fd, ptr, size);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+    }
+
+    class BenchClient {
+    private:
+        static constexpr int MAX_CAS_ATTEMPTS = 4;
+
+        int32_t client_id_;
+        const BenchOptions& options_;
+        ClientConnection connection_;
+        KeyChooser keys_;
+        std::mt19937_64 rng_;
+        bool connected_;
+        Response last_;
+        std::unordered_map<int32_t, uint64_t> versions_;
+
+        ResponseStatus call(OperationType operation, int32_t employee_id, const Employee& employee = Employee(),
+                            uint64_t version = 0) {
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = employee_id;
+            req.operation = operation;
+            req.employee = employee;
+            req.version = version;
+
+            if (!connection_.send_request(req, last_)) {
+                connected_ = false;
+                return ResponseStatus::ERROR;
+            }
+            return last_.status;
+        }
+
+        Outcome outcome_of(ResponseStatus status) {
+            if (status == ResponseStatus::SUCCESS) {
+                return OK;
+            }
+            return status == ResponseStatus::LOCKED || status == ResponseStatus::CONFLICT ? BUSY : FAILED;
+        }
+
+        Employee next_update(int32_t employee_id) {
+            return Employee(employee_id, "c" + std::to_string(client_id_), static_cast<double>(rng_() % 160));
+        }
+
+        Outcome compare_and_set(int32_t employee_id) {
+            Employee updated = next_update(employee_id);
+            uint64_t& version = versions_[employee_id];
+            ResponseStatus status = ResponseStatus::CONFLICT;
+            for (int attempt = 0; attempt < MAX_CAS_ATTEMPTS && status == ResponseStatus::CONFLICT; ++attempt) {
+                status = call(OperationType::COMPARE_AND_SET, employee_id, updated, version);
+                version = last_.version;
+            }
+            return outcome_of(status);
+        }
+
+        Outcome add_hours(int32_t employee_id) {
+            AtomicUpdate update;
+            update.kind = AtomicKind::ADD_HOURS;
+            update.hours = 1.0;
+
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = employee_id;
+            req.operation = OperationType::ATOMIC;
+
+            std::vector<char> payload(sizeof(update));
+            std::memcpy(payload.data(), &update, sizeof(update));
+            std::vector<char> reply_payload;
+            if (!connection_.send_request(req, payload, last_, reply_payload)) {
+                connected_ = false;
+                return FAILED;
+            }
+            return outcome_of(last_.status);
+        }
+
+        Outcome perform(WorkloadOp op, int32_t employee_id) {
+            if (op == WorkloadOp::WRITE && options_.writes == WriteMode::CAS) {
+                return compare_and_set(employee_id);
+            }
+            if (op == WorkloadOp::WRITE && options_.writes == WriteMode::ATOMIC) {
+                return add_hours(employee_id);
+            }
+
+            OperationType first = op == WorkloadOp::READ ? OperationType::READ : OperationType::WRITE;
+            ResponseStatus status = call(first, employee_id);
+            if (status != ResponseStatus::SUCCESS) {
+                return outcome_of(status);
+            }
+            if (options_.writes == WriteMode::CAS) {
+                versions_[employee_id] = last_.version;
+            }
+
+            if (op == WorkloadOp::WRITE) {
+                status = call(OperationType::WRITE, employee_id, next_update(employee_id));
+            }
+            ResponseStatus unlocked = call(OperationType::UNLOCK, employee_id);
+            return outcome_of(status == ResponseStatus::SUCCESS ? unlocked : status);
+        }
+
+    public:
+        BenchClient(int32_t client_id, const BenchOptions& options)
+            : client_id_(client_id), options_(options),
+              connection_(client_id, options.transport == Transport::SOCKET ? SERVER_SOCKET : SERVER_FIFO,
+                          ClientConnection::DEFAULT_PIPELINE_DEPTH, options.transport),
+              keys_(options.keys, options.distribution, options.theta, options.seed + client_id),
+              rng_(options.seed * 31 + client_id), connected_(false) {}
+
+        int run(int start_fd, int out_fd) {
+            connected_ = connection_.connect(10000);
+            char go;
+            while (::read(start_fd, &go, 1) < 0 && errno == EINTR) {
+            }
+            if (!connected_) {
+                std::cerr << "Client " << client_id_ << ": Failed to connect to server" << std::endl;
+                ClientSummary summary{0, 0, 0};
+                write_all(out_fd, &summary, sizeof(summary));
+                return 1;
+            }
+
+            std::vector<Sample> samples;
+            samples.reserve(options_.duration > 0 ? 1 << 16 : options_.operations);
+            auto started = BenchClock::now();
+            auto deadline = started + std::chrono::duration_cast<BenchClock::duration>(
+                std::chrono::duration<double>(options_.duration));
+
+            while (connected_) {
+                if (options_.duration > 0 ? BenchClock::now() >= deadline : samples.size() >= options_.operations) {
+                    break;
+                }
+                WorkloadOp op = options_.mix.pick(rng_);
+                int32_t employee_id = keys_.next();
+                auto op_started = BenchClock::now();
+                Outcome outcome = perform(op, employee_id);
+                auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                    BenchClock::now() - op_started).count();
+                samples.push_back(Sample{static_cast<uint8_t>(op), outcome, static_cast<uint32_t>(micros)});
+            }
+            auto finished = BenchClock::now();
+
+            call(OperationType::EXIT, 0);
+            connection_.disconnect();
+
+            ClientSummary summary{started.time_since_epoch().count(), finished.time_since_epoch().count(),
+                                  samples.size()};
+            bool sent = write_all(out_fd, &summary, sizeof(summary)) &&
+                        write_all(out_fd, samples.data(), samples.size() * sizeof(Sample));
+            return sent && connected_ ? 0 : 1;
+        }
+    };
+
+    class Benchmark {
+    private:
+        static constexpr size_t OPS = 3;
+
+        BenchOptions options_;
+        pid_t server_pid_;
+        LatencyHistogram latency_[OPS];
+        uint64_t outcomes_[OPS][3] = {};
+
+        bool start_server() {
+            if (options_.server_binary.empty()) {
+                return true;
+            }
+
+            std::vector<std::string> args = {
+                options_.server_binary, "--headless", "--file=bench_employees.dat",
+                "--employees=" + std::to_string(options_.keys), "--log-level=warn"
+            };
+            args.insert(args.end(), options_.server_args.begin(), options_.server_args.end());
+
+            server_pid_ = fork();
+            if (server_pid_ < 0) {
+                return false;
+            }
+            if (server_pid_ == 0) {
+                std::vector<char*> argv;
+                for (auto& arg : args) {
+                    argv.push_back(const_cast<char*>(arg.c_str()));
+                }
+                argv.push_back(nullptr);
+                execv(argv[0], argv.data());
+                std::cerr << "Failed to start server " << argv[0] << ": " << strerror(errno) << std::endl;
+                _exit(127);
+            }
+            return true;
+        }
+
+        void stop_server() {
+            if (server_pid_ <= 0) {
+                return;
+            }
+            kill(server_pid_, SIGTERM);
+            int status;
+            waitpid(server_pid_, &status, 0);
+            server_pid_ = -1;
+        }
+
+        void report(int64_t started_ns, int64_t finished_ns, size_t failed_clients) {
+            uint64_t total = 0;
+            for (size_t op = 0; op < OPS; ++op) {
+                total += latency_[op].count();
+            }
+            double seconds = std::max<int64_t>(1, finished_ns - started_ns) / 1e9;
+
+            std::cout << "Benchmark: " << options_.clients << " clients, mix " << options_.mix.read << ":"
+                      << options_.mix.write << ":" << options_.mix.lock << ", "
+                      << (options_.distribution == KeyDistribution::ZIPFIAN ? "zipfian" : "uniform")
+                      << " over " << options_.keys << " keys"
+                      << (options_.writes == WriteMode::CAS ? ", compare-and-set writes\n" :
+                          options_.writes == WriteMode::ATOMIC ? ", atomic writes\n" : "\n");
+            std::cout << "Completed " << total << " operations in " << std::fixed << std::setprecision(3)
+                      << seconds << " s: " << std::setprecision(0) << total / seconds << " ops/s\n";
+            if (failed_clients > 0) {
+                std::cout << failed_clients << " clients failed or disconnected early\n";
+            }
+
+            std::cout << std::left << std::setw(7) << "op" << std::right
+                      << std::setw(10) << "count" << std::setw(10) << "ok" << std::setw(8) << "busy"
+                      << std::setw(8) << "failed" << std::setw(10) << "mean_us" << std::setw(8) << "p50"
+                      << std::setw(8) << "p90" << std::setw(8) << "p99" << std::setw(9) << "max" << "\n";
+            for (size_t op = 0; op < OPS; ++op) {
+                const LatencyHistogram& histogram = latency_[op];
+                if (histogram.count() == 0) {
+                    continue;
+                }
+                std::cout << std::left << std::setw(7) << OperationMix::name(static_cast<WorkloadOp>(op))
+                          << std::right << std::setw(10) << histogram.count()
+                          << std::setw(10) << outcomes_[op][OK] << std::setw(8) << outcomes_[op][BUSY]
+                          << std::setw(8) << outcomes_[op][FAILED]
+                          << std::setw(10) << std::setprecision(1) << histogram.mean()
+                          << std::setw(8) << histogram.percentile(0.50) << std::setw(8) << histogram.percentile(0.90)
+                          << std::setw(8) << histogram.percentile(0.99) << std::setw(9) << histogram.max() << "\n";
+            }
+        }
+
+    public:
+        explicit Benchmark(const BenchOptions& options) : options_(options), server_pid_(-1) {}
+
+        int run() {
+            if (!start_server()) {
+                std::cerr << "Failed to fork server" << std::endl;
+                return 1;
+            }
+
+            int start_pipe[2];
+            if (pipe(start_pipe) != 0) {
+                stop_server();
+                return 1;
+            }
+
+            std::vector<pid_t> children;
+            std::vector<int> results;
+            for (size_t i = 0; i < options_.clients; ++i) {
+                int result_pipe[2];
+                if (pipe(result_pipe) != 0) {
+                    break;
+                }
+                pid_t pid = fork();
+                if (pid == 0) {
+                    ::close(start_pipe[1]);
+                    ::close(result_pipe[0]);
+                    for (int fd : results) {
+                        ::close(fd);
+                    }
+                    BenchClient client(options_.first_client_id + static_cast<int32_t>(i), options_);
+                    _exit(client.run(start_pipe[0], result_pipe[1]));
+                }
+                ::close(result_pipe[1]);
+                if (pid < 0) {
+                    ::close(result_pipe[0]);
+                    break;
+                }
+                children.push_back(pid);
+                results.push_back(result_pipe[0]);
+            }
+            ::close(start_pipe[0]);
+            ::close(start_pipe[1]);
+
+            int64_t started_ns = INT64_MAX;
+            int64_t finished_ns = 0;
+            size_t failed_clients = options_.clients - children.size();
+            for (int fd : results) {
+                ClientSummary summary;
+                std::vector<Sample> samples;
+                if (read_all(fd, &summary, sizeof(summary))) {
+                    samples.resize(summary.samples);
+                    if (!samples.empty() && !read_all(fd, samples.data(), samples.size() * sizeof(Sample))) {
+                        samples.clear();
+                    }
+                }
+                ::close(fd);
+                if (samples.empty()) {
+                    ++failed_clients;
+                    continue;
+                }
+
+                started_ns = std::min(started_ns, summary.started_ns);
+                finished_ns = std::max(finished_ns, summary.finished_ns);
+                for (const Sample& sample : samples) {
+                    latency_[sample.op].record(sample.micros);
+                    ++outcomes_[sample.op][sample.outcome];
+                }
+            }
+
+            bool clean = true;
+            for (pid_t pid : children) {
+                int status;
+                waitpid(pid, &status, 0);
+                clean = clean && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            }
+            stop_server();
+
+            if (finished_ns == 0) {
+                std::cerr << "No client completed any operation" << std::endl;
+                return 1;
+            }
+            report(started_ns, finished_ns, failed_clients);
+            return clean ? 0 : 1;
+        }
+    };
+}
+
+int main(int argc, char* argv[]) {
+    using namespace EmployeeSystem;
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    BenchOptions options;
+    bool valid = true;
+    for (int i = 1; i < argc && valid; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--clients=", 0) == 0) {
+            options.clients = std::stoul(arg.substr(10));
+        } else if (arg.rfind("--ops=", 0) == 0) {
+            options.operations = std::stoul(arg.substr(6));
+        } else if (arg.rfind("--duration=", 0) == 0) {
+            options.duration = std::stod(arg.substr(11));
+        } else if (arg.rfind("--keys=", 0) == 0) {
+            options.keys = std::max(1ul, std::stoul(arg.substr(7)));
+        } else if (arg.rfind("--mix=", 0) == 0) {
+            valid = options.mix.parse(arg.substr(6));
+        } else if (arg.rfind("--dist=", 0) == 0) {
+            valid = parse_distribution(arg.substr(7), options.distribution);
+        } else if (arg.rfind("--theta=", 0) == 0) {
+            options.theta = std::stod(arg.substr(8));
+        } else if (arg == "--transport=fifo") {
+            options.transport = Transport::FIFO;
+        } else if (arg == "--transport=socket") {
+            options.transport = Transport::SOCKET;
+        } else if (arg == "--transport=shm") {
+            options.transport = Transport::SHM;
+        } else if (arg.rfind("--server=", 0) == 0) {
+            options.server_binary = arg.substr(9);
+        } else if (arg.rfind("--first-client=", 0) == 0) {
+            options.first_client_id = std::stoi(arg.substr(15));
+        } else if (arg.rfind("--seed=", 0) == 0) {
+            options.seed = std::stoull(arg.substr(7));
+        } else if (arg == "--writes=lock") {
+            options.writes = WriteMode::LOCKED;
+        } else if (arg == "--writes=cas" || arg == "--optimistic") {
+            options.writes = WriteMode::CAS;
+        } else if (arg == "--writes=atomic") {
+            options.writes = WriteMode::ATOMIC;
+        } else if (arg == "--") {
+            options.server_args.assign(argv + i + 1, argv + argc);
+            break;
+        } else {
+            valid = false;
+        }
+    }
+
+    if (!valid || options.clients == 0) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--clients=N] [--ops=N | --duration=SEC] [--keys=N] [--mix=READ:WRITE:LOCK]"
+                  << " [--dist=uniform|zipf] [--theta=T] [--transport=fifo|socket|shm]"
+                  << " [--writes=lock|cas|atomic] [--server=PATH] [--first-client=ID] [--seed=N] [-- server args...]"
+                  << std::endl;
+        std::cerr << "Example: " << argv[0] << " --server=./server --clients=8 --dist=zipf -- --workers=4"
+                  << std::endl;
+        return 1;
+    }
+
+    Benchmark benchmark(options);
+    return benchmark.run();
+}
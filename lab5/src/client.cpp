@@ -9,83 +9,47 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <csignal>
+#include <vector>
 
-namespace EmployeeSystem {
-    
-    constexpr char SERVER_FIFO[] = "/tmp/employee_server_fifo";
-    constexpr char CLIENT_FIFO_TEMPLATE[] = "/tmp/employee_client_%d_fifo";
-    
-    #pragma pack(push, 1)
-    struct Employee {
-        int32_t id;
-        char name[10];
-        double hours;
-    };
+#include "employee_types.h"
+#include "client_connection.h"
+#include "protocol.h"
 
-    enum class OperationType : uint8_t {
-        READ = 'R',
-        WRITE = 'W',
-        UNLOCK = 'U',
-        EXIT = 'X'
-    };
-
-    enum class ResponseStatus : uint8_t {
-        SUCCESS = 'S',
-        ERROR = 'E',
-        LOCKED = 'L',
-        NOT_FOUND = 'N'
-    };
-
-    struct Request {
-        int32_t client_id;
-        int32_t employee_id;
-        OperationType operation;
-        Employee employee;
-        uint64_t timestamp;
-    };
-
-    struct Response {
-        int32_t employee_id;
-        ResponseStatus status;
-        Employee employee;
-        uint64_t timestamp;
-    };
-    #pragma pack(pop)
+namespace EmployeeSystem {
 
     class EmployeeClient {
     private:
         int client_id_;
-        std::string client_fifo_path_;
-        
-        bool wait_for_fifo(const std::string& path, std::ios_base::openmode mode, int max_attempts = 10) {
-            for (int i = 0; i < max_attempts; ++i) {
-                std::fstream test_file(path, mode);
-                if (test_file.is_open()) {
-                    return true;
-                }
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
-            return false;
-        }
+        uint32_t lock_timeout_ms_;
+        ClientConnection connection_;
         
     public:
-        EmployeeClient(int client_id) : client_id_(client_id) {
-            char buffer[100];
-            snprintf(buffer, sizeof(buffer), CLIENT_FIFO_TEMPLATE, client_id_);
-            client_fifo_path_ = buffer;
+        EmployeeClient(int client_id, uint32_t lock_timeout_ms = 0, Transport transport = Transport::FIFO) 
+            : client_id_(client_id), lock_timeout_ms_(lock_timeout_ms), 
+              connection_(client_id, transport == Transport::SOCKET ? SERVER_SOCKET : SERVER_FIFO, 
+                          ClientConnection::DEFAULT_PIPELINE_DEPTH, transport) {}
+        
+        static const char* transport_name(Transport transport) {
+            switch (transport) {
+                case Transport::SHM: return "shared memory";
+                case Transport::SOCKET: return "socket";
+                default: return "FIFO";
+            }
         }
         
         bool initialize() {
-            unlink(client_fifo_path_.c_str());
-            
-            if (mkfifo(client_fifo_path_.c_str(), 0666) == -1) {
-                std::cerr << "Client " << client_id_ << ": Failed to create FIFO - " 
+            if (!connection_.connect()) {
+                std::cerr << "Client " << client_id_ << ": Failed to connect to server - " 
                           << strerror(errno) << std::endl;
+                std::cerr << "  Server " << transport_name(connection_.transport()) << ": " 
+                          << (connection_.transport() == Transport::SOCKET ? SERVER_SOCKET : SERVER_FIFO) << std::endl;
                 return false;
             }
             
-            std::cout << "Client " << client_id_ << ": Created FIFO at " 
-                      << client_fifo_path_ << std::endl;
+            std::cout << "Client " << client_id_ << ": Connected via " 
+                      << transport_name(connection_.transport()) << " at " 
+                      << connection_.reply_path() << std::endl;
             return true;
         }
         
@@ -95,49 +59,10 @@ namespace EmployeeSystem {
             resp.employee_id = req.employee_id;
             resp.timestamp = 0;
             
-            std::ofstream server_fifo(SERVER_FIFO, std::ios::binary);
-            if (!server_fifo) {
-                std::cerr << "Client " << client_id_ << ": Cannot open server FIFO for writing" << std::endl;
-                std::cerr << "  Path: " << SERVER_FIFO << std::endl;
-                std::cerr << "  Error: " << strerror(errno) << std::endl;
-                return resp;
-            }
-            
-            server_fifo.write(reinterpret_cast<const char*>(&req), sizeof(Request));
-            server_fifo.flush();
-            
-            if (!server_fifo) {
-                std::cerr << "Client " << client_id_ << ": Failed to write request to server FIFO" << std::endl;
-                return resp;
-            }
-            
-            server_fifo.close();
-            
-            auto start_time = std::chrono::steady_clock::now();
-            const auto timeout = std::chrono::seconds(5);
-            
-            while (std::chrono::steady_clock::now() - start_time < timeout) {
-                std::ifstream client_fifo(client_fifo_path_, std::ios::binary);
-                
-                if (client_fifo) {
-                    if (client_fifo.read(reinterpret_cast<char*>(&resp), sizeof(Response))) {
-                        return resp;
-                    }
-                    
-                    client_fifo.close();
-                }
-                
-                std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            }
-            
-            std::cerr << "Client " << client_id_ << ": Timeout waiting for response from server" << std::endl;
-            std::cerr << "  Expected response in FIFO: " << client_fifo_path_ << std::endl;
-            
-            struct stat buffer;
-            if (stat(client_fifo_path_.c_str(), &buffer) != 0) {
-                std::cerr << "  FIFO does not exist!" << std::endl;
-            } else {
-                std::cerr << "  FIFO exists but no response received" << std::endl;
+            if (!connection_.send_request(req, resp, 5000 + static_cast<int>(req.lock_timeout_ms))) {
+                resp.status = ResponseStatus::ERROR;
+                std::cerr << "Client " << client_id_ << ": No response from server" << std::endl;
+                std::cerr << "  Reply FIFO: " << connection_.reply_path() << std::endl;
             }
             
             return resp;
@@ -153,6 +78,7 @@ namespace EmployeeSystem {
             req.employee_id = employee_id;
             req.operation = OperationType::READ;
             req.timestamp = static_cast<uint64_t>(time(nullptr));
+            req.lock_timeout_ms = lock_timeout_ms_;
             
             std::cout << "Client " << client_id_ << ": Sending read request for employee " 
                       << employee_id << std::endl;
@@ -166,7 +92,8 @@ namespace EmployeeSystem {
                     std::cout << "\nEmployee record:\n"
                               << "  ID: " << resp.employee.id << "\n"
                               << "  Name: " << resp.employee.name << "\n"
-                              << "  Hours: " << resp.employee.hours << std::endl;
+                              << "  Hours: " << resp.employee.hours << "\n"
+                              << "  Version: " << resp.version << std::endl;
                     
                     std::cout << "\nKeep lock? (y/n): ";
                     char choice;
@@ -216,6 +143,7 @@ namespace EmployeeSystem {
             lock_req.employee_id = employee_id;
             lock_req.operation = OperationType::WRITE;
             lock_req.timestamp = static_cast<uint64_t>(time(nullptr));
+            lock_req.lock_timeout_ms = lock_timeout_ms_;
             
             std::cout << "Client " << client_id_ << ": Acquiring write lock for employee " 
                       << employee_id << std::endl;
@@ -279,6 +207,168 @@ namespace EmployeeSystem {
             std::cout << "Write lock released." << std::endl;
         }
         
+        void modify_employee_optimistic() {
+            int employee_id;
+            std::cout << "\nClient " << client_id_ << " - Enter employee ID to modify: ";
+            std::cin >> employee_id;
+            
+            Request peek_req;
+            peek_req.client_id = client_id_;
+            peek_req.employee_id = employee_id;
+            peek_req.operation = OperationType::PEEK;
+            peek_req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            Response current = send_request(peek_req);
+            if (current.status != ResponseStatus::SUCCESS) {
+                std::cout << "Cannot read record: " 
+                          << (current.status == ResponseStatus::NOT_FOUND ? "Employee not found" : 
+                              "Error accessing record") << std::endl;
+                return;
+            }
+            
+            std::cin.ignore();
+            while (true) {
+                std::cout << "\nCurrent record (version " << current.version << "):\n"
+                          << "  ID: " << current.employee.id << "\n"
+                          << "  Name: " << current.employee.name << "\n"
+                          << "  Hours: " << current.employee.hours << std::endl;
+                
+                Employee modified_emp = current.employee;
+                std::cout << "\nEnter new name (max 9 chars, current: '" << modified_emp.name << "'): ";
+                std::cin.getline(modified_emp.name, sizeof(modified_emp.name));
+                std::cout << "Enter new hours (current: " << modified_emp.hours << "): ";
+                std::cin >> modified_emp.hours;
+                std::cin.ignore();
+                
+                Request cas_req;
+                cas_req.client_id = client_id_;
+                cas_req.employee_id = employee_id;
+                cas_req.operation = OperationType::COMPARE_AND_SET;
+                cas_req.employee = modified_emp;
+                cas_req.version = current.version;
+                cas_req.timestamp = static_cast<uint64_t>(time(nullptr));
+                
+                Response cas_resp = send_request(cas_req);
+                if (cas_resp.status == ResponseStatus::SUCCESS) {
+                    std::cout << "Record updated successfully (version " << cas_resp.version << ")." << std::endl;
+                    return;
+                }
+                if (cas_resp.status != ResponseStatus::CONFLICT) {
+                    std::cout << (cas_resp.status == ResponseStatus::LOCKED ? 
+                                  "Record is locked by another client" : "Error updating record") << std::endl;
+                    return;
+                }
+                
+                std::cout << "Record was changed by another client. Retry with the new values? (y/n): ";
+                char choice;
+                std::cin >> choice;
+                std::cin.ignore();
+                if (choice != 'y' && choice != 'Y') {
+                    return;
+                }
+                current = cas_resp;
+            }
+        }
+        
+        void add_hours() {
+            int employee_id;
+            AtomicUpdate update;
+            std::cout << "\nClient " << client_id_ << " - Enter employee ID and hours to add: ";
+            std::cin >> employee_id >> update.hours;
+            update.kind = AtomicKind::ADD_HOURS;
+            
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = employee_id;
+            req.operation = OperationType::ATOMIC;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            std::vector<char> payload(sizeof(update));
+            memcpy(payload.data(), &update, sizeof(update));
+            
+            Response resp;
+            std::vector<char> reply_payload;
+            if (!connection_.send_request(req, payload, resp, reply_payload)) {
+                std::cout << "ERROR - Communication error with server" << std::endl;
+                return;
+            }
+            
+            switch (resp.status) {
+                case ResponseStatus::SUCCESS:
+                    std::cout << "Employee " << resp.employee.id << " (" << resp.employee.name 
+                              << ") now has " << resp.employee.hours << " hours." << std::endl;
+                    break;
+                case ResponseStatus::LOCKED:
+                    std::cout << "LOCKED - Record is locked by another client" << std::endl;
+                    break;
+                case ResponseStatus::NOT_FOUND:
+                    std::cout << "NOT FOUND - Employee ID " << employee_id << " not found" << std::endl;
+                    break;
+                default:
+                    std::cout << "Error updating record" << std::endl;
+                    break;
+            }
+        }
+        
+        void insert_employee() {
+            Employee emp;
+            std::cout << "\nClient " << client_id_ << " - New employee ID: ";
+            std::cin >> emp.id;
+            std::cout << "  Name: ";
+            std::cin.ignore();
+            std::cin.getline(emp.name, sizeof(emp.name));
+            std::cout << "  Hours: ";
+            std::cin >> emp.hours;
+            
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = emp.id;
+            req.operation = OperationType::INSERT;
+            req.employee = emp;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            Response resp = send_request(req);
+            switch (resp.status) {
+                case ResponseStatus::SUCCESS:
+                    std::cout << "Employee " << emp.id << " added." << std::endl;
+                    break;
+                case ResponseStatus::DUPLICATE:
+                    std::cout << "DUPLICATE - Employee ID " << emp.id << " already exists" << std::endl;
+                    break;
+                default:
+                    std::cout << "Error adding employee" << std::endl;
+                    break;
+            }
+        }
+        
+        void delete_employee() {
+            int employee_id;
+            std::cout << "\nClient " << client_id_ << " - Enter employee ID to delete: ";
+            std::cin >> employee_id;
+            
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = employee_id;
+            req.operation = OperationType::DELETE;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            Response resp = send_request(req);
+            switch (resp.status) {
+                case ResponseStatus::SUCCESS:
+                    std::cout << "Employee " << employee_id << " deleted." << std::endl;
+                    break;
+                case ResponseStatus::LOCKED:
+                    std::cout << "LOCKED - Record is locked by another client" << std::endl;
+                    break;
+                case ResponseStatus::NOT_FOUND:
+                    std::cout << "NOT FOUND - Employee ID " << employee_id << " not found" << std::endl;
+                    break;
+                default:
+                    std::cout << "Error deleting employee" << std::endl;
+                    break;
+            }
+        }
+        
         void unlock_employee() {
             int employee_id;
             std::cout << "\nClient " << client_id_ << " - Enter employee ID to unlock: ";
@@ -299,6 +389,181 @@ namespace EmployeeSystem {
             }
         }
         
+        void read_employee_range() {
+            int first_id, last_id;
+            std::cout << "\nClient " << client_id_ << " - Enter first and last employee ID: ";
+            std::cin >> first_id >> last_id;
+            
+            std::vector<int32_t> ids;
+            for (int id = first_id; id <= last_id && ids.size() < MAX_BATCH_READ; ++id) {
+                ids.push_back(id);
+            }
+            read_employees(ids);
+        }
+        
+        void read_employees(const std::vector<int32_t>& ids) {
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = ids.empty() ? 0 : ids.front();
+            req.operation = OperationType::BATCH_READ;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            std::vector<char> payload(ids.size() * sizeof(int32_t));
+            if (!ids.empty()) {
+                memcpy(payload.data(), ids.data(), payload.size());
+            }
+            
+            Response resp;
+            std::vector<char> reply_payload;
+            std::vector<BatchResult> results;
+            if (!connection_.send_request(req, payload, resp, reply_payload) || 
+                resp.status != ResponseStatus::SUCCESS || !decode_items(reply_payload, results)) {
+                std::cout << "ERROR - Batch read failed" << std::endl;
+                return;
+            }
+            
+            size_t found = 0;
+            for (const auto& result : results) {
+                if (result.status == ResponseStatus::SUCCESS) {
+                    ++found;
+                    std::cout << "  ID: " << result.employee.id 
+                              << ", Name: " << result.employee.name 
+                              << ", Hours: " << result.employee.hours << std::endl;
+                } else if (result.status == ResponseStatus::LOCKED) {
+                    std::cout << "  ID: " << result.employee_id << " is locked by another client" << std::endl;
+                }
+            }
+            std::cout << "Read " << found << " of " << results.size() << " employees in one request." << std::endl;
+        }
+        
+        void find_employees_by_name() {
+            std::string name;
+            std::cout << "\nClient " << client_id_ << " - Enter name (end with * to match a prefix): ";
+            std::cin.ignore();
+            std::getline(std::cin, name);
+            
+            NameQuery query;
+            if (!name.empty() && name.back() == '*') {
+                name.pop_back();
+                query.match = NameMatch::PREFIX;
+            } else {
+                query.match = NameMatch::EXACT;
+            }
+            strncpy(query.name, name.c_str(), sizeof(query.name) - 1);
+            
+            Request req;
+            req.client_id = client_id_;
+            req.operation = OperationType::QUERY_NAME;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            std::vector<char> payload(sizeof(query));
+            memcpy(payload.data(), &query, sizeof(query));
+            
+            Response resp;
+            std::vector<char> reply_payload;
+            std::vector<int32_t> ids;
+            if (!connection_.send_request(req, payload, resp, reply_payload) || 
+                resp.status != ResponseStatus::SUCCESS || !decode_items(reply_payload, ids)) {
+                std::cout << "ERROR - Name query failed" << std::endl;
+                return;
+            }
+            
+            std::cout << ids.size() << " employees match." << std::endl;
+            if (ids.empty()) {
+                return;
+            }
+            if (ids.size() > MAX_BATCH_READ) {
+                ids.resize(MAX_BATCH_READ);
+            }
+            read_employees(ids);
+        }
+        
+        RangeQuery read_range() {
+            RangeQuery query;
+            int first_id, last_id;
+            std::cout << "\nClient " << client_id_ << " - Enter first and last employee ID (0 0 for all): ";
+            std::cin >> first_id >> last_id;
+            if (first_id != 0 || last_id != 0) {
+                query.first_id = first_id;
+                query.last_id = last_id;
+            }
+            return query;
+        }
+        
+        bool send_range_query(OperationType operation, const RangeQuery& query, std::vector<char>& reply_payload) {
+            Request req;
+            req.client_id = client_id_;
+            req.employee_id = query.first_id;
+            req.operation = operation;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            std::vector<char> payload(sizeof(query));
+            memcpy(payload.data(), &query, sizeof(query));
+            
+            Response resp;
+            return connection_.send_request(req, payload, resp, reply_payload, 30000) && 
+                   resp.status == ResponseStatus::SUCCESS;
+        }
+        
+        void scan_employees() {
+            RangeQuery query = read_range();
+            size_t total = 0;
+            while (true) {
+                std::vector<char> reply_payload;
+                std::vector<Employee> employees;
+                if (!send_range_query(OperationType::SCAN, query, reply_payload) || 
+                    !decode_items(reply_payload, employees)) {
+                    std::cout << "ERROR - Scan failed" << std::endl;
+                    return;
+                }
+                for (const auto& emp : employees) {
+                    std::cout << "  ID: " << emp.id << ", Name: " << emp.name 
+                              << ", Hours: " << emp.hours << std::endl;
+                }
+                total += employees.size();
+                if (employees.size() < MAX_SCAN_RECORDS || employees.back().id >= query.last_id) {
+                    break;
+                }
+                query.first_id = employees.back().id + 1;
+            }
+            std::cout << "Scanned " << total << " employees." << std::endl;
+        }
+        
+        void summarize_hours() {
+            RangeQuery query = read_range();
+            std::vector<char> reply_payload;
+            std::vector<AggregateResult> results;
+            if (!send_range_query(OperationType::AGGREGATE, query, reply_payload) || 
+                !decode_items(reply_payload, results) || results.size() != 1) {
+                std::cout << "ERROR - Aggregate query failed" << std::endl;
+                return;
+            }
+            
+            const AggregateResult& result = results.front();
+            std::cout << "Employees: " << result.count << "\n"
+                      << "  Total hours: " << result.sum << "\n"
+                      << "  Min hours: " << result.min << "\n"
+                      << "  Max hours: " << result.max << "\n"
+                      << "  Average hours: " << result.avg << std::endl;
+        }
+        
+        void show_server_stats() {
+            Request req;
+            req.client_id = client_id_;
+            req.operation = OperationType::STATS;
+            req.timestamp = static_cast<uint64_t>(time(nullptr));
+            
+            Response resp;
+            std::vector<char> reply_payload;
+            if (!connection_.send_request(req, std::vector<char>(), resp, reply_payload) || 
+                resp.status != ResponseStatus::SUCCESS) {
+                std::cout << "ERROR - Could not fetch server statistics" << std::endl;
+                return;
+            }
+            std::cout << "\n=== Server statistics ===\n" 
+                      << std::string(reply_payload.begin(), reply_payload.end());
+        }
+        
         void run() {
             std::cout << "\n=== Client " << client_id_ << " started ===\n";
             
@@ -308,6 +573,15 @@ namespace EmployeeSystem {
                           << "2. Modify employee record\n"
                           << "3. Unlock employee record\n"
                           << "4. Exit\n"
+                          << "5. Read employee range\n"
+                          << "6. Server statistics\n"
+                          << "7. Modify employee record (optimistic)\n"
+                          << "8. Add hours worked\n"
+                          << "9. Add employee\n"
+                          << "10. Delete employee\n"
+                          << "11. Find employees by name\n"
+                          << "12. Scan employees\n"
+                          << "13. Hours summary\n"
                           << "Choice: ";
                 
                 int choice;
@@ -323,7 +597,7 @@ namespace EmployeeSystem {
                     case 3:
                         unlock_employee();
                         break;
-                    case 4:
+                    case 4: {
                         std::cout << "Client " << client_id_ << " exiting...\n";
                         
                         Request exit_req;
@@ -334,6 +608,34 @@ namespace EmployeeSystem {
                         send_request(exit_req);
                         
                         return;
+                    }
+                    case 5:
+                        read_employee_range();
+                        break;
+                    case 6:
+                        show_server_stats();
+                        break;
+                    case 7:
+                        modify_employee_optimistic();
+                        break;
+                    case 8:
+                        add_hours();
+                        break;
+                    case 9:
+                        insert_employee();
+                        break;
+                    case 10:
+                        delete_employee();
+                        break;
+                    case 11:
+                        find_employees_by_name();
+                        break;
+                    case 12:
+                        scan_employees();
+                        break;
+                    case 13:
+                        summarize_hours();
+                        break;
                     default:
                         std::cout << "Invalid choice. Please try again.\n";
                         break;
@@ -342,7 +644,7 @@ namespace EmployeeSystem {
         }
         
         ~EmployeeClient() {
-            unlink(client_fifo_path_.c_str());
+            connection_.disconnect();
             std::cout << "Client " << client_id_ << " FIFO cleaned up." << std::endl;
         }
     };
@@ -351,14 +653,29 @@ namespace EmployeeSystem {
 int main(int argc, char* argv[]) {
     using namespace EmployeeSystem;
     
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <client_id>" << std::endl;
-        std::cerr << "Example: " << argv[0] << " 1" << std::endl;
+    Transport transport = Transport::FIFO;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--shm") {
+            transport = Transport::SHM;
+        } else if (arg == "--socket") {
+            transport = Transport::SOCKET;
+        } else if (arg == "--fifo") {
+            transport = Transport::FIFO;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    
+    if (args.size() != 1 && args.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " <client_id> [lock_timeout_ms] [--shm|--socket|--fifo]" << std::endl;
+        std::cerr << "Example: " << argv[0] << " 1 2000 --shm" << std::endl;
         return 1;
     }
     
     try {
-        int client_id = std::stoi(argv[1]);
+        int client_id = std::stoi(args[0]);
         
         if (client_id < 1 || client_id > 100) {
             std::cerr << "Client ID must be between 1 and 100" << std::endl;
@@ -366,17 +683,18 @@ int main(int argc, char* argv[]) {
         }
         
         std::cout << "Starting Client " << client_id << "..." << std::endl;
+        std::signal(SIGPIPE, SIG_IGN);
+        
+        uint32_t lock_timeout_ms = args.size() == 2 ? static_cast<uint32_t>(std::stoul(args[1])) : 0;
         
-        EmployeeClient client(client_id);
+        EmployeeClient client(client_id, lock_timeout_ms, transport);
         
+        std::cout << "Waiting for server to be ready..." << std::endl;
         if (!client.initialize()) {
             std::cerr << "Client initialization failed" << std::endl;
             return 1;
         }
         
-        std::cout << "Waiting for server to be ready..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-        
         client.run();
         
     } catch (const std::exception& e) {
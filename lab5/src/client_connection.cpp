@@ -0,0 +1,178 @@
+#include "client_connection.h"
+#include "protocol.h"
+#include "shm_channel.h"
+#include "socket_channel.h"
+#include <chrono>
+#include <ctime>
+#include <fcntl.h>
+#include <thread>
+
+namespace EmployeeSystem {
+
+    ClientConnection::ClientConnection(int32_t client_id, const std::string& server_path, size_t max_in_flight,
+                                       Transport transport)
+        : client_id_(client_id), server_path_(server_path),
+          reply_path_(transport == Transport::SHM ? FIFOManager::client_shm_name(client_id) :
+                      transport == Transport::SOCKET ? server_path : FIFOManager::client_fifo_path(client_id)),
+          transport_(transport), max_in_flight_(max_in_flight > 0 ? max_in_flight : 1), next_request_id_(0) {}
+
+    bool ClientConnection::connect(int timeout_ms) {
+        disconnect();
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        if (transport_ == Transport::SOCKET) {
+            while (!(replies_ = SocketChannel::connect(server_path_))) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            server_ = replies_;
+        } else if (transport_ == Transport::SHM) {
+            replies_ = ShmChannel::create(reply_path_);
+        } else if (FIFOManager::create_fifo(reply_path_)) {
+            replies_ = FIFOManager::open_channel(reply_path_, O_RDONLY);
+        }
+        if (!replies_) {
+            return false;
+        }
+
+        while (!server_ && !(server_ = FIFOManager::open_channel(server_path_, O_WRONLY))) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                disconnect();
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+
+        Request req;
+        req.client_id = client_id_;
+        req.operation = OperationType::CONNECT;
+        req.timestamp = static_cast<uint64_t>(time(nullptr));
+
+        std::vector<char> payload;
+        if (transport_ == Transport::SHM) {
+            payload.assign(reply_path_.begin(), reply_path_.end());
+        }
+
+        Response resp;
+        std::vector<char> reply_payload;
+        if (!send_request(req, payload, resp, reply_payload, timeout_ms) || 
+            resp.status != ResponseStatus::SUCCESS) {
+            disconnect();
+            return false;
+        }
+        if (transport_ == Transport::SHM) {
+            server_ = replies_;
+        }
+        return true;
+    }
+
+    bool ClientConnection::send_request(const Request& req, Response& resp, int timeout_ms) {
+        std::vector<char> reply_payload;
+        return send_request(req, std::vector<char>(), resp, reply_payload, timeout_ms);
+    }
+
+    bool ClientConnection::send_request(const Request& req, const std::vector<char>& payload, Response& resp,
+                                        std::vector<char>& reply_payload, int timeout_ms) {
+        uint32_t request_id = submit(req, payload, timeout_ms);
+        return request_id != 0 && wait(request_id, resp, reply_payload, timeout_ms);
+    }
+
+    uint32_t ClientConnection::submit(const Request& req, const std::vector<char>& payload, int timeout_ms) {
+        if (!is_connected()) {
+            return 0;
+        }
+        while (in_flight_.size() >= max_in_flight_) {
+            if (!receive_one(timeout_ms)) {
+                return 0;
+            }
+        }
+
+        Request framed = req;
+        if (++next_request_id_ == 0) {
+            ++next_request_id_;
+        }
+        framed.request_id = next_request_id_;
+
+        std::vector<char> frame;
+        if (!encode_request(framed, payload.data(), payload.size(), frame) || 
+            !server_->send(frame.data(), frame.size())) {
+            return 0;
+        }
+        in_flight_.insert(framed.request_id);
+        return framed.request_id;
+    }
+
+    bool ClientConnection::wait(uint32_t request_id, Response& resp, std::vector<char>& reply_payload, 
+                                int timeout_ms) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            auto done = completed_.find(request_id);
+            if (done != completed_.end()) {
+                resp = done->second.response;
+                reply_payload.swap(done->second.payload);
+                completed_.erase(done);
+                return true;
+            }
+            if (!in_flight_.count(request_id)) {
+                return false;
+            }
+
+            int wait_ms = -1;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                wait_ms = left > 0 ? static_cast<int>(left) : 0;
+            }
+            if (!receive_one(wait_ms)) {
+                in_flight_.erase(request_id);
+                return false;
+            }
+        }
+    }
+
+    bool ClientConnection::receive_one(int timeout_ms) {
+        Completion completion;
+        char* header = reinterpret_cast<char*>(&completion.response);
+        if (!replies_ || !replies_->receive(header, 1, timeout_ms)) {
+            return false;
+        }
+        if (!replies_->receive(header + 1, sizeof(Response) - 1, timeout_ms) ||
+            completion.response.payload_length > MAX_RESPONSE_PAYLOAD) {
+            disconnect();
+            return false;
+        }
+
+        completion.payload.resize(completion.response.payload_length);
+        if (!completion.payload.empty() && 
+            !replies_->receive(completion.payload.data(), completion.payload.size(), timeout_ms)) {
+            disconnect();
+            return false;
+        }
+
+        uint32_t request_id = completion.response.request_id;
+        if (in_flight_.erase(request_id) > 0) {
+            completed_[request_id] = std::move(completion);
+        }
+        return true;
+    }
+
+    void ClientConnection::disconnect() {
+        in_flight_.clear();
+        completed_.clear();
+        server_.reset();
+        if (replies_) {
+            replies_->close();
+            replies_.reset();
+            if (transport_ == Transport::FIFO) {
+                FIFOManager::remove_fifo(reply_path_);
+            }
+        }
+    }
+
+    ClientConnection::~ClientConnection() {
+        disconnect();
+    }
+
+}
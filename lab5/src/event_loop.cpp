@@ -0,0 +1,213 @@
+#include "event_loop.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+namespace EmployeeSystem {
+
+    namespace {
+
+        constexpr int MAX_EVENTS = 64;
+
+#ifdef __linux__
+        uint32_t to_native(uint32_t events) {
+            uint32_t native = 0;
+            if (events & EventLoop::READABLE) native |= EPOLLIN;
+            if (events & EventLoop::WRITABLE) native |= EPOLLOUT;
+            return native;
+        }
+
+        uint32_t from_native(uint32_t native) {
+            uint32_t events = 0;
+            if (native & EPOLLIN) events |= EventLoop::READABLE;
+            if (native & EPOLLOUT) events |= EventLoop::WRITABLE;
+            if (native & (EPOLLHUP | EPOLLERR)) events |= EventLoop::HANGUP;
+            return events;
+        }
+#else
+        short to_native(uint32_t events) {
+            short native = 0;
+            if (events & EventLoop::READABLE) native |= POLLIN;
+            if (events & EventLoop::WRITABLE) native |= POLLOUT;
+            return native;
+        }
+
+        uint32_t from_native(short native) {
+            uint32_t events = 0;
+            if (native & POLLIN) events |= EventLoop::READABLE;
+            if (native & POLLOUT) events |= EventLoop::WRITABLE;
+            if (native & (POLLHUP | POLLERR | POLLNVAL)) events |= EventLoop::HANGUP;
+            return events;
+        }
+#endif
+
+    }
+
+    EventLoop::EventLoop() : poll_fd_(-1), wake_read_fd_(-1), wake_write_fd_(-1) {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return;
+        }
+        wake_read_fd_ = fds[0];
+        wake_write_fd_ = fds[1];
+        for (int fd : fds) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+
+#ifdef __linux__
+        poll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (poll_fd_ >= 0) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = wake_read_fd_;
+            ::epoll_ctl(poll_fd_, EPOLL_CTL_ADD, wake_read_fd_, &ev);
+        }
+#else
+        poll_fd_ = 0;
+#endif
+    }
+
+    bool EventLoop::is_valid() const {
+        return poll_fd_ >= 0 && wake_read_fd_ >= 0;
+    }
+
+    bool EventLoop::add(int fd, uint32_t events, Handler handler) {
+        std::lock_guard<std::mutex> lock(mutex_);
+#ifdef __linux__
+        epoll_event ev{};
+        ev.events = to_native(events);
+        ev.data.fd = fd;
+        if (::epoll_ctl(poll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            return false;
+        }
+#endif
+        registrations_[fd] = Registration{events, std::make_shared<Handler>(std::move(handler))};
+        return true;
+    }
+
+    bool EventLoop::modify(int fd, uint32_t enable, uint32_t disable) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = registrations_.find(fd);
+            if (it == registrations_.end()) {
+                return false;
+            }
+            uint32_t events = (it->second.events | enable) & ~disable;
+            if (events == it->second.events) {
+                return true;
+            }
+#ifdef __linux__
+            epoll_event ev{};
+            ev.events = to_native(events);
+            ev.data.fd = fd;
+            if (::epoll_ctl(poll_fd_, EPOLL_CTL_MOD, fd, &ev) != 0) {
+                return false;
+            }
+#endif
+            it->second.events = events;
+        }
+#ifndef __linux__
+        wakeup();
+#endif
+        return true;
+    }
+
+    void EventLoop::remove(int fd) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (registrations_.erase(fd) == 0) {
+            return;
+        }
+#ifdef __linux__
+        ::epoll_ctl(poll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+    }
+
+    void EventLoop::drain_wakeups() {
+        char buffer[64];
+        while (::read(wake_read_fd_, buffer, sizeof(buffer)) > 0) {
+        }
+    }
+
+    int EventLoop::run_once(int timeout_ms) {
+        std::vector<std::pair<int, uint32_t>> ready;
+
+#ifdef __linux__
+        epoll_event events[MAX_EVENTS];
+        int count = ::epoll_wait(poll_fd_, events, MAX_EVENTS, timeout_ms);
+        if (count < 0) {
+            return errno == EINTR ? 0 : -1;
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_read_fd_) {
+                drain_wakeups();
+            } else {
+                ready.emplace_back(fd, from_native(events[i].events));
+            }
+        }
+#else
+        std::vector<pollfd> fds;
+        fds.push_back(pollfd{wake_read_fd_, POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& entry : registrations_) {
+                fds.push_back(pollfd{entry.first, to_native(entry.second.events), 0});
+            }
+        }
+        int count = ::poll(fds.data(), fds.size(), timeout_ms);
+        if (count < 0) {
+            return errno == EINTR ? 0 : -1;
+        }
+        if (fds[0].revents) {
+            drain_wakeups();
+        }
+        for (size_t i = 1; i < fds.size() && ready.size() < MAX_EVENTS; ++i) {
+            if (fds[i].revents) {
+                ready.emplace_back(fds[i].fd, from_native(fds[i].revents));
+            }
+        }
+#endif
+
+        int dispatched = 0;
+        for (const auto& event : ready) {
+            std::shared_ptr<Handler> handler;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = registrations_.find(event.first);
+                if (it == registrations_.end()) {
+                    continue;
+                }
+                handler = it->second.handler;
+            }
+            (*handler)(event.second);
+            ++dispatched;
+        }
+        return dispatched;
+    }
+
+    void EventLoop::wakeup() {
+        char byte = 1;
+        while (::write(wake_write_fd_, &byte, 1) < 0 && errno == EINTR) {
+        }
+    }
+
+    EventLoop::~EventLoop() {
+#ifdef __linux__
+        if (poll_fd_ >= 0) {
+            ::close(poll_fd_);
+        }
+#endif
+        if (wake_read_fd_ >= 0) {
+            ::close(wake_read_fd_);
+            ::close(wake_write_fd_);
+        }
+    }
+
+}
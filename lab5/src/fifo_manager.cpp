@@ -1,9 +1,176 @@
 #include "fifo_manager.h"
+#include <cerrno>
+#include <cstdio>
+#include <chrono>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 namespace EmployeeSystem {
 
+    OutboundQueue::OutboundQueue(Writer write) 
+        : write_(std::move(write)), offset_(0), failed_(false) {}
+
+    SendResult OutboundQueue::push(const void* data, size_t size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failed_) {
+            return SendResult::FAILED;
+        }
+        const char* ptr = static_cast<const char*>(data);
+        if (offset_ < buffer_.size()) {
+            if (buffer_.size() - offset_ + size > MAX_QUEUED_BYTES) {
+                failed_ = true;
+                buffer_.clear();
+                offset_ = 0;
+                return SendResult::FAILED;
+            }
+            buffer_.insert(buffer_.end(), ptr, ptr + size);
+            return SendResult::QUEUED;
+        }
+
+        while (size > 0) {
+            ssize_t n = write_(ptr, size);
+            if (n < 0) {
+                failed_ = true;
+                return SendResult::FAILED;
+            }
+            if (n == 0) {
+                break;
+            }
+            ptr += n;
+            size -= static_cast<size_t>(n);
+        }
+        if (size == 0) {
+            return SendResult::SENT;
+        }
+        buffer_.assign(ptr, ptr + size);
+        offset_ = 0;
+        blocked_since_ = Channel::Clock::now();
+        return SendResult::QUEUED;
+    }
+
+    SendResult OutboundQueue::flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return drain_locked();
+    }
+
+    SendResult OutboundQueue::drain_locked() {
+        if (failed_) {
+            return SendResult::FAILED;
+        }
+        while (offset_ < buffer_.size()) {
+            ssize_t n = write_(buffer_.data() + offset_, buffer_.size() - offset_);
+            if (n < 0) {
+                failed_ = true;
+                buffer_.clear();
+                offset_ = 0;
+                return SendResult::FAILED;
+            }
+            if (n == 0) {
+                buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<ptrdiff_t>(offset_));
+                offset_ = 0;
+                return SendResult::QUEUED;
+            }
+            offset_ += static_cast<size_t>(n);
+            blocked_since_ = Channel::Clock::now();
+        }
+        buffer_.clear();
+        offset_ = 0;
+        return SendResult::SENT;
+    }
+
+    bool OutboundQueue::blocked_since(Channel::Clock::time_point& since) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (offset_ == buffer_.size()) {
+            return false;
+        }
+        since = blocked_since_;
+        return true;
+    }
+
+    size_t OutboundQueue::queued() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffer_.size() - offset_;
+    }
+
+    FIFOChannel::FIFOChannel(int fd) 
+        : fd_(fd), outbound_([this](const char* data, size_t size) { return write_some(data, size); }) {}
+
+    bool FIFOChannel::send(const void* data, size_t size) {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        const char* ptr = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = ::write(fd_, ptr, size);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd pfd{fd_, POLLOUT, 0};
+                ::poll(&pfd, 1, -1);
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    ssize_t FIFOChannel::write_some(const char* data, size_t size) {
+        while (true) {
+            ssize_t n = ::write(fd_, data, size);
+            if (n >= 0) {
+                return n;
+            }
+            if (errno != EINTR) {
+                return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+            }
+        }
+    }
+
+    bool FIFOChannel::receive(void* data, size_t size, int timeout_ms) {
+        char* ptr = static_cast<char*>(data);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        while (size > 0) {
+            int wait_ms = -1;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                wait_ms = left > 0 ? static_cast<int>(left) : 0;
+            }
+
+            pollfd pfd{fd_, POLLIN, 0};
+            int ready = ::poll(&pfd, 1, wait_ms);
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ready <= 0) {
+                return false;
+            }
+
+            ssize_t n = ::read(fd_, ptr, size);
+            if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    FIFOChannel::~FIFOChannel() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
     bool FIFOManager::create_fifo(const std::string& path) {
         ::unlink(path.c_str());
         return ::mkfifo(path.c_str(), 0666) == 0;
@@ -19,4 +186,25 @@ namespace EmployeeSystem {
         return stream->is_open() ? std::move(stream) : nullptr;
     }
 
-} 
\ No newline at end of file
+    std::unique_ptr<FIFOChannel> FIFOManager::open_channel(const std::string& path, int flags) {
+        int fd = ::open(path.c_str(), flags | O_NONBLOCK);
+        if (fd < 0) {
+            return nullptr;
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        return std::make_unique<FIFOChannel>(fd);
+    }
+
+    std::string FIFOManager::client_fifo_path(int32_t client_id) {
+        char buffer[100];
+        snprintf(buffer, sizeof(buffer), CLIENT_FIFO_TEMPLATE, client_id);
+        return buffer;
+    }
+
+    std::string FIFOManager::client_shm_name(int32_t client_id) {
+        char buffer[100];
+        snprintf(buffer, sizeof(buffer), CLIENT_SHM_TEMPLATE, client_id);
+        return buffer;
+    }
+
+}
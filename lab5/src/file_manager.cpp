@@ -1,90 +1,742 @@
 #include "file_manager.h"
 #include "employee_types.h"
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace EmployeeSystem {
 
-    FileManager::FileManager(const std::string& filename) : filename_(filename) {}
-    
+    namespace {
+
+        bool read_exact(int fd, void* data, size_t size, off_t offset) {
+            char* ptr = static_cast<char*>(data);
+            while (size > 0) {
+                ssize_t n = ::pread(fd, ptr, size, offset);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+                offset += n;
+            }
+            return true;
+        }
+
+        bool write_exact(int fd, const void* data, size_t size, off_t offset) {
+            const char* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+                ssize_t n = ::pwrite(fd, ptr, size, offset);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+                offset += n;
+            }
+            return true;
+        }
+
+        off_t record_offset(size_t slot) {
+            return static_cast<off_t>(slot * sizeof(Employee));
+        }
+
+        bool sync_fd(int fd) {
+#ifdef __linux__
+            return ::fdatasync(fd) == 0;
+#else
+            return ::fsync(fd) == 0;
+#endif
+        }
+
+        constexpr size_t MIN_MAP_BYTES = 64 * 1024;
+        constexpr size_t CHUNK_RECORDS = 4096;
+
+    }
+
+    FileManager::FileManager(const std::string& filename, const FileOptions& options)
+        : filename_(filename), options_(options), fd_(-1), map_(nullptr),
+          map_capacity_(0), record_count_(0), stored_count_(0),
+          epoch_(static_cast<uint32_t>(std::chrono::system_clock::now().time_since_epoch().count())) {
+        if (options_.mode == StorageMode::LOG) {
+            log_ = std::make_unique<LogStore>(filename_, options_.segment_records, options_.sync == SyncPolicy::SYNC);
+        }
+    }
+
     bool FileManager::open() {
-        std::lock_guard<std::mutex> lock(file_mutex_);
-        file_.open(filename_, std::ios::binary | std::ios::in | std::ios::out);
-        if (!file_.is_open()) {
-            file_.open(filename_, std::ios::binary | std::ios::out);
-            file_.close();
-            file_.open(filename_, std::ios::binary | std::ios::in | std::ios::out);
+        std::unique_lock<std::shared_mutex> lock(file_mutex_);
+        if (!open_file(O_RDWR | O_CREAT)) {
+            return false;
+        }
+        if (options_.cache_records > 0 && options_.mode != StorageMode::MMAP && !cache_) {
+            cache_ = std::make_unique<RecordCache>(options_.cache_records,
+                [this](size_t slot, const Employee& employee) { return write_slot(slot, employee); });
+        }
+        if (options_.wal && !recover_from_wal()) {
+            return false;
+        }
+        return build_index();
+    }
+
+    bool FileManager::recover_from_wal() {
+        if (!wal_) {
+            wal_ = std::make_unique<WriteAheadLog>(filename_ + ".wal");
+        }
+
+        size_t replayed = wal_->replay([this](uint64_t slot, const Employee& employee) {
+            if (slot > record_count_ || !write_slot(slot, employee)) {
+                return false;
+            }
+            if (slot == record_count_) {
+                ++record_count_;
+            }
+            return true;
+        });
+
+        if (!wal_->open()) {
+            return false;
+        }
+        return (replayed == 0 || sync_storage()) && wal_->reset();
+    }
+
+    bool FileManager::sync_storage() {
+        if (log_) {
+            return log_->sync();
+        }
+        if (map_) {
+            return ::msync(map_, stored_count_ * sizeof(Employee), MS_SYNC) == 0;
+        }
+        return sync_fd(fd_);
+    }
+
+    bool FileManager::checkpoint_locked() {
+        if (!is_open()) {
+            return true;
+        }
+        if (!wal_) {
+            return flush_cache();
+        }
+        return wal_->flush() && flush_pending_writes() && flush_cache() && sync_storage() && wal_->reset();
+    }
+
+    bool FileManager::checkpoint() {
+        std::unique_lock<std::shared_mutex> lock(file_mutex_);
+        return checkpoint_locked();
+    }
+
+    bool FileManager::commit(uint64_t seq) {
+        if (!wal_) {
+            return true;
+        }
+        if (!wal_->sync(seq)) {
+            return false;
+        }
+        if (wal_->logged_records() >= options_.checkpoint_interval) {
+            checkpoint();
+        }
+        return true;
+    }
+
+    bool FileManager::open_file(int flags) {
+        close_file();
+        if (log_) {
+            if (!log_->open()) {
+                return false;
+            }
+            record_count_ = log_->slot_count();
+            stored_count_ = record_count_;
+            return true;
+        }
+
+        fd_ = ::open(filename_.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            return false;
+        }
+        record_count_ = static_cast<size_t>(st.st_size) / sizeof(Employee);
+        stored_count_ = record_count_;
+        return ensure_mapped(record_count_ * sizeof(Employee));
+    }
+
+    void FileManager::close_file() {
+        unmap();
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        if (log_) {
+            log_->close();
+        }
+        index_.clear();
+        versions_.clear();
+        free_slots_.clear();
+        names_.clear();
+        if (cache_) {
+            cache_->clear();
+        }
+        pending_writes_.clear();
+        record_count_ = 0;
+        stored_count_ = 0;
+    }
+
+    bool FileManager::is_open() {
+        return log_ ? log_->is_open() : fd_ >= 0;
+    }
+
+    bool FileManager::ensure_mapped(size_t bytes) {
+        if (options_.mode != StorageMode::MMAP || bytes <= map_capacity_) {
+            return true;
+        }
+
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t capacity = std::max({bytes, map_capacity_ * 2, MIN_MAP_BYTES});
+        capacity = (capacity + page - 1) / page * page;
+
+        unmap();
+        void* addr = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        map_ = static_cast<char*>(addr);
+        map_capacity_ = capacity;
+        return true;
+    }
+
+    void FileManager::unmap() {
+        if (map_) {
+            ::munmap(map_, map_capacity_);
+            map_ = nullptr;
+            map_capacity_ = 0;
+        }
+    }
+
+    void FileManager::reset_versions() {
+        ++epoch_;
+        versions_.assign(record_count_, static_cast<uint64_t>(epoch_) << 32 | 1);
+    }
+
+    void FileManager::index_slot(const Employee& employee, size_t slot) {
+        if (employee.id == TOMBSTONE_ID) {
+            free_slots_.push_back(slot);
+        } else if (index_.emplace(employee.id, slot).second) {
+            names_.put(employee.id, employee.name);
+        }
+    }
+
+    bool FileManager::build_index() {
+        reset_versions();
+        index_.clear();
+        free_slots_.clear();
+        names_.clear();
+        index_.reserve(record_count_);
+
+        if (map_) {
+            const Employee* records = reinterpret_cast<const Employee*>(map_);
+            for (size_t slot = 0; slot < record_count_; ++slot) {
+                index_slot(records[slot], slot);
+            }
+            return true;
+        }
+
+        std::vector<Employee> chunk(std::min(record_count_, CHUNK_RECORDS));
+        for (size_t first = 0; first < record_count_; first += CHUNK_RECORDS) {
+            size_t count = std::min(CHUNK_RECORDS, record_count_ - first);
+            if (!read_slots(first, count, chunk.data())) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                index_slot(chunk[i], first + i);
+            }
+        }
+        return true;
+    }
+
+    bool FileManager::read_slots(size_t first, size_t count, Employee* out,
+                                 const std::map<size_t, Employee>* dirty) {
+        if (first + count > record_count_) {
+            return false;
+        }
+
+        size_t stored = first < stored_count_ ? std::min(count, stored_count_ - first) : 0;
+        if (map_) {
+            std::memcpy(out, map_ + record_offset(first), stored * sizeof(Employee));
+        } else if (log_) {
+            for (size_t i = 0; i < stored; ++i) {
+                if (!log_->read(first + i, out[i])) {
+                    return false;
+                }
+            }
+        } else if (stored > 0 && !read_exact(fd_, out, stored * sizeof(Employee), record_offset(first))) {
+            return false;
+        }
+
+        auto overlay = [&](const std::map<size_t, Employee>& writes) {
+            for (auto it = writes.lower_bound(first); it != writes.end() && it->first < first + count; ++it) {
+                out[it->first - first] = it->second;
+            }
+        };
+        overlay(pending_writes_);
+        if (dirty) {
+            overlay(*dirty);
+        }
+        return true;
+    }
+
+    bool FileManager::write_slot(size_t slot, const Employee& employee) {
+        off_t offset = record_offset(slot);
+        size_t end = static_cast<size_t>(offset) + sizeof(Employee);
+
+        if (log_ || options_.mode != StorageMode::MMAP) {
+            bool written = log_ ? log_->append(slot, employee) : write_exact(fd_, &employee, sizeof(Employee), offset);
+            if (!written) {
+                return false;
+            }
+            stored_count_ = std::max(stored_count_, slot + 1);
+            return log_ || options_.sync != SyncPolicy::SYNC || sync_fd(fd_);
+        }
+
+        if (slot >= stored_count_) {
+            if (::ftruncate(fd_, static_cast<off_t>(end)) != 0) {
+                return false;
+            }
+            stored_count_ = slot + 1;
+        }
+        if (!ensure_mapped(end)) {
+            return false;
+        }
+
+        std::memcpy(map_ + offset, &employee, sizeof(Employee));
+
+        if (options_.sync == SyncPolicy::NONE) {
+            return true;
+        }
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t page_start = static_cast<size_t>(offset) / page * page;
+        int flags = options_.sync == SyncPolicy::SYNC ? MS_SYNC : MS_ASYNC;
+        return ::msync(map_ + page_start, end - page_start, flags) == 0;
+    }
+
+    bool FileManager::read_slot(size_t slot, Employee& employee) {
+        if (cache_ && cache_->lookup(slot, employee)) {
+            return true;
+        }
+        if (!read_slots(slot, 1, &employee)) {
+            return false;
+        }
+        return !cache_ || cache_->fill(slot, employee);
+    }
+
+    bool FileManager::store_slot(size_t slot, const Employee& employee) {
+        if (wal_) {
+            if (pending_writes_.size() >= options_.checkpoint_interval && !checkpoint_locked()) {
+                return false;
+            }
+            pending_writes_[slot] = employee;
+            return !cache_ || cache_->put(slot, employee, false);
+        }
+        if (!cache_) {
+            return write_slot(slot, employee);
+        }
+        if (options_.cache_policy == CachePolicy::WRITE_BACK && slot < record_count_) {
+            return cache_->put(slot, employee, true);
+        }
+        return write_slot(slot, employee) && cache_->put(slot, employee, false);
+    }
+
+    bool FileManager::flush_cache() {
+        return !cache_ || cache_->flush();
+    }
+
+    bool FileManager::flush_pending_writes() {
+        for (auto it = pending_writes_.begin(); it != pending_writes_.end(); it = pending_writes_.erase(it)) {
+            if (!write_slot(it->first, it->second)) {
+                return false;
+            }
         }
-        return file_.is_open();
+        return true;
     }
-    
+
+    RecordCache::Stats FileManager::cache_stats() {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        return cache_ ? cache_->stats() : RecordCache::Stats();
+    }
+
+    LogStore::Stats FileManager::log_stats() {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        return log_ ? log_->stats() : LogStore::Stats();
+    }
+
     std::vector<Employee> FileManager::read_all() {
-        std::lock_guard<std::mutex> lock(file_mutex_);
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
         std::vector<Employee> employees;
-        
-        file_.seekg(0, std::ios::end);
-        size_t file_size = file_.tellg();
-        file_.seekg(0, std::ios::beg);
-        
-        size_t num_employees = file_size / sizeof(Employee);
+
+        if (!is_open()) {
+            return employees;
+        }
+
+        std::map<size_t, Employee> dirty = cache_ ? cache_->dirty_entries() : std::map<size_t, Employee>();
+        size_t num_employees = record_count_;
+        bool from_file = !log_ && pending_writes_.empty() && dirty.empty();
+        if (from_file) {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0) {
+                return employees;
+            }
+            num_employees = static_cast<size_t>(st.st_size) / sizeof(Employee);
+        }
         employees.resize(num_employees);
-        
-        if (num_employees > 0) {
-            file_.read(reinterpret_cast<char*>(employees.data()), 
-                      num_employees * sizeof(Employee));
+
+        if (num_employees == 0) {
+            return employees;
         }
-        
+
+        bool ok = !from_file || (num_employees <= record_count_ && map_)
+            ? read_slots(0, num_employees, employees.data(), &dirty)
+            : read_exact(fd_, employees.data(), num_employees * sizeof(Employee), 0);
+        if (!ok) {
+            employees.clear();
+        }
+        employees.erase(std::remove_if(employees.begin(), employees.end(),
+                                       [](const Employee& emp) { return emp.id == TOMBSTONE_ID; }),
+                        employees.end());
+
         return employees;
     }
-    
+
     bool FileManager::write_all(const std::vector<Employee>& employees) {
-        std::lock_guard<std::mutex> lock(file_mutex_);
-        
-        std::string temp_filename = filename_ + ".tmp";
-        std::ofstream temp_file(temp_filename, std::ios::binary | std::ios::trunc);
-        
-        if (!temp_file.is_open()) {
+        std::unique_lock<std::shared_mutex> lock(file_mutex_);
+
+        if (!checkpoint_locked() || !(log_ ? log_->reset(employees) : replace_file(employees))) {
             return false;
         }
-        
-        if (!employees.empty()) {
-            temp_file.write(reinterpret_cast<const char*>(employees.data()),
-                           employees.size() * sizeof(Employee));
+
+        if (!open_file(O_RDWR)) {
+            return false;
+        }
+
+        reset_versions();
+        index_.reserve(employees.size());
+        for (size_t slot = 0; slot < employees.size(); ++slot) {
+            index_slot(employees[slot], slot);
+        }
+
+        return true;
+    }
+
+    bool FileManager::replace_file(const std::vector<Employee>& employees) {
+        std::string temp_filename = filename_ + ".tmp";
+        int temp_fd = ::open(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (temp_fd < 0) {
+            return false;
         }
-        
-        temp_file.close();
-        
-        std::ifstream check_file(temp_filename, std::ios::binary | std::ios::ate);
-        if (!check_file.is_open() || check_file.tellg() != employees.size() * sizeof(Employee)) {
+
+        size_t bytes = employees.size() * sizeof(Employee);
+        bool written = bytes == 0 || write_exact(temp_fd, employees.data(), bytes, 0);
+
+        struct stat st;
+        written = written && ::fstat(temp_fd, &st) == 0 && static_cast<size_t>(st.st_size) == bytes;
+        written = written && (!wal_ || sync_fd(temp_fd));
+        ::close(temp_fd);
+
+        if (!written) {
             std::remove(temp_filename.c_str());
             return false;
         }
-        check_file.close();
-        
-        if (std::rename(temp_filename.c_str(), filename_.c_str()) != 0) {
+
+        return std::rename(temp_filename.c_str(), filename_.c_str()) == 0;
+    }
+
+    bool FileManager::contains(int32_t id) {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        return index_.count(id) > 0;
+    }
+
+    bool FileManager::read_employee(int32_t id, Employee& employee) {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        auto it = index_.find(id);
+        if (it == index_.end()) {
+            return false;
+        }
+        return read_slot(it->second, employee);
+    }
+
+    bool FileManager::read_employee(int32_t id, Employee& employee, uint64_t& version) {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        auto it = index_.find(id);
+        if (it == index_.end() || !read_slot(it->second, employee)) {
             return false;
         }
-        
-        file_.close();
-        file_.open(filename_, std::ios::binary | std::ios::in | std::ios::out);
-        
-        return file_.is_open();
+        version = versions_[it->second];
+        return true;
     }
-    
+
+    bool FileManager::replace_slot(std::unordered_map<int32_t, size_t>::iterator it, const Employee& employee,
+                                   uint64_t& seq) {
+        size_t slot = it->second;
+        if (employee.id == TOMBSTONE_ID || (employee.id != it->first && index_.count(employee.id))) {
+            return false;
+        }
+
+        if (!store_slot(slot, employee)) {
+            return false;
+        }
+        if (wal_) {
+            seq = wal_->append(slot, employee);
+        }
+
+        ++versions_[slot];
+        if (employee.id != it->first) {
+            names_.erase(it->first);
+            index_.erase(it);
+            index_.emplace(employee.id, slot);
+        }
+        names_.put(employee.id, employee.name);
+        return true;
+    }
+
+    bool FileManager::update_employee(int32_t id, const Employee& employee) {
+        uint64_t seq = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(file_mutex_);
+            auto it = index_.find(id);
+            if (it == index_.end() || !replace_slot(it, employee, seq)) {
+                return false;
+            }
+        }
+        return commit(seq);
+    }
+
+    UpdateResult FileManager::compare_and_update(int32_t id, uint64_t expected_version, const Employee& employee,
+                                                 Employee& current, uint64_t& version) {
+        uint64_t seq = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(file_mutex_);
+            auto it = index_.find(id);
+            if (it == index_.end()) {
+                return UpdateResult::NOT_FOUND;
+            }
+
+            size_t slot = it->second;
+            if (versions_[slot] != expected_version) {
+                version = versions_[slot];
+                return read_slot(slot, current) ? UpdateResult::CONFLICT : UpdateResult::FAILED;
+            }
+            if (!replace_slot(it, employee, seq)) {
+                return UpdateResult::FAILED;
+            }
+            version = versions_[slot];
+            current = employee;
+        }
+        return commit(seq) ? UpdateResult::APPLIED : UpdateResult::FAILED;
+    }
+
+    UpdateResult FileManager::modify_employee(int32_t id, const std::function<bool(Employee&)>& modify,
+                                              Employee& current, uint64_t& version) {
+        uint64_t seq = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(file_mutex_);
+            auto it = index_.find(id);
+            if (it == index_.end()) {
+                return UpdateResult::NOT_FOUND;
+            }
+
+            size_t slot = it->second;
+            if (!read_slot(slot, current)) {
+                return UpdateResult::FAILED;
+            }
+            version = versions_[slot];
+            Employee modified = current;
+            if (!modify(modified)) {
+                return UpdateResult::CONFLICT;
+            }
+            if (!replace_slot(it, modified, seq)) {
+                return UpdateResult::FAILED;
+            }
+            version = versions_[slot];
+            current = modified;
+        }
+        return commit(seq) ? UpdateResult::APPLIED : UpdateResult::FAILED;
+    }
+
+    UpdateResult FileManager::insert_employee(const Employee& employee, uint64_t& version) {
+        uint64_t seq = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(file_mutex_);
+            if (employee.id == TOMBSTONE_ID) {
+                return UpdateResult::FAILED;
+            }
+            if (index_.count(employee.id)) {
+                return UpdateResult::DUPLICATE;
+            }
+
+            bool reuse = !free_slots_.empty();
+            size_t slot = reuse ? free_slots_.back() : record_count_;
+            if (!store_slot(slot, employee)) {
+                return UpdateResult::FAILED;
+            }
+            if (wal_) {
+                seq = wal_->append(slot, employee);
+            }
+
+            if (reuse) {
+                free_slots_.pop_back();
+                ++versions_[slot];
+            } else {
+                ++record_count_;
+                versions_.push_back(static_cast<uint64_t>(epoch_) << 32 | 1);
+            }
+            index_.emplace(employee.id, slot);
+            names_.put(employee.id, employee.name);
+            version = versions_[slot];
+        }
+        return commit(seq) ? UpdateResult::APPLIED : UpdateResult::FAILED;
+    }
+
+    UpdateResult FileManager::delete_employee(int32_t id) {
+        uint64_t seq = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(file_mutex_);
+            auto it = index_.find(id);
+            if (it == index_.end()) {
+                return UpdateResult::NOT_FOUND;
+            }
+
+            size_t slot = it->second;
+            Employee tombstone;
+            tombstone.id = TOMBSTONE_ID;
+            if (!store_slot(slot, tombstone)) {
+                return UpdateResult::FAILED;
+            }
+            if (wal_) {
+                seq = wal_->append(slot, tombstone);
+            }
+
+            ++versions_[slot];
+            names_.erase(id);
+            index_.erase(it);
+            free_slots_.push_back(slot);
+        }
+        return commit(seq) ? UpdateResult::APPLIED : UpdateResult::FAILED;
+    }
+
+    std::vector<int32_t> FileManager::find_by_name(const std::string& name, bool prefix, size_t limit) {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        return names_.find(name, prefix, limit);
+    }
+
+    bool FileManager::scan(const std::function<bool(const Employee&)>& visit) {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        std::map<size_t, Employee> dirty = cache_ ? cache_->dirty_entries() : std::map<size_t, Employee>();
+        if (map_ && pending_writes_.empty() && dirty.empty()) {
+            const Employee* records = reinterpret_cast<const Employee*>(map_);
+            for (size_t slot = 0; slot < record_count_; ++slot) {
+                if (records[slot].id != TOMBSTONE_ID && !visit(records[slot])) {
+                    break;
+                }
+            }
+            return true;
+        }
+
+        std::vector<Employee> chunk(std::min(record_count_, CHUNK_RECORDS));
+        for (size_t first = 0; first < record_count_; first += CHUNK_RECORDS) {
+            size_t count = std::min(CHUNK_RECORDS, record_count_ - first);
+            if (!read_slots(first, count, chunk.data(), &dirty)) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                if (chunk[i].id != TOMBSTONE_ID && !visit(chunk[i])) {
+                    return true;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool FileManager::scan_range(int32_t first_id, int32_t last_id, size_t limit, std::vector<Employee>& employees) {
+        auto by_id = [](const Employee& a, const Employee& b) { return a.id < b.id; };
+        employees.clear();
+        if (limit == 0) {
+            return true;
+        }
+
+        bool ok = scan([&](const Employee& employee) {
+            if (employee.id < first_id || employee.id > last_id) {
+                return true;
+            }
+            if (employees.size() < limit) {
+                employees.push_back(employee);
+                std::push_heap(employees.begin(), employees.end(), by_id);
+            } else if (employee.id < employees.front().id) {
+                std::pop_heap(employees.begin(), employees.end(), by_id);
+                employees.back() = employee;
+                std::push_heap(employees.begin(), employees.end(), by_id);
+            }
+            return true;
+        });
+        std::sort_heap(employees.begin(), employees.end(), by_id);
+        return ok;
+    }
+
+    bool FileManager::aggregate(int32_t first_id, int32_t last_id, AggregateResult& result) {
+        result = AggregateResult();
+        bool ok = scan([&](const Employee& employee) {
+            if (employee.id < first_id || employee.id > last_id) {
+                return true;
+            }
+            if (result.count == 0 || employee.hours < result.min) {
+                result.min = employee.hours;
+            }
+            if (result.count == 0 || employee.hours > result.max) {
+                result.max = employee.hours;
+            }
+            result.sum += employee.hours;
+            ++result.count;
+            return true;
+        });
+        result.avg = result.count == 0 ? 0.0 : result.sum / static_cast<double>(result.count);
+        return ok;
+    }
+
+    size_t FileManager::size() {
+        std::shared_lock<std::shared_mutex> lock(file_mutex_);
+        return index_.size();
+    }
+
     Employee* FileManager::find_employee(std::vector<Employee>& employees, int32_t id) {
         auto it = std::find_if(employees.begin(), employees.end(),
                              [id](const Employee& emp) { return emp.id == id; });
         return it != employees.end() ? &(*it) : nullptr;
     }
-    
+
     void FileManager::close() {
-        std::lock_guard<std::mutex> lock(file_mutex_);
-        if (file_.is_open()) {
-            file_.close();
+        std::unique_lock<std::shared_mutex> lock(file_mutex_);
+        checkpoint_locked();
+        if (map_ && options_.sync != SyncPolicy::NONE) {
+            ::msync(map_, stored_count_ * sizeof(Employee), MS_SYNC);
+        }
+        close_file();
+        if (wal_) {
+            wal_->close();
         }
     }
-    
+
     FileManager::~FileManager() {
         close();
     }
 
-} 
\ No newline at end of file
+}
\ No newline at end of file
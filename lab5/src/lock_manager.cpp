@@ -1,81 +1,666 @@
 #include "lock_manager.h"
+#include <algorithm>
 
 namespace EmployeeSystem {
 
-    bool LockManager::acquire_read_lock(int32_t employee_id, int32_t client_id) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        auto write_it = write_locks_.find(employee_id);
-        if (write_it != write_locks_.end() && write_it->second != client_id) {
+    bool LockManager::LockEntry::has_reader(int32_t client_id) const {
+        for (uint32_t i = 0; i < inline_readers; ++i) {
+            if (readers[i] == client_id) {
+                return true;
+            }
+        }
+        return std::find(extra_readers.begin(), extra_readers.end(), client_id) != extra_readers.end();
+    }
+
+    void LockManager::LockEntry::add_reader(int32_t client_id) {
+        if (has_reader(client_id)) {
+            return;
+        }
+        if (inline_readers < INLINE_READERS) {
+            readers[inline_readers++] = client_id;
+        } else {
+            extra_readers.push_back(client_id);
+        }
+    }
+
+    void LockManager::LockEntry::remove_reader(int32_t client_id) {
+        for (uint32_t i = 0; i < inline_readers; ++i) {
+            if (readers[i] == client_id) {
+                if (!extra_readers.empty()) {
+                    readers[i] = extra_readers.back();
+                    extra_readers.pop_back();
+                } else {
+                    readers[i] = readers[--inline_readers];
+                }
+                return;
+            }
+        }
+        auto it = std::find(extra_readers.begin(), extra_readers.end(), client_id);
+        if (it != extra_readers.end()) {
+            *it = extra_readers.back();
+            extra_readers.pop_back();
+        }
+    }
+
+    LockManager::LockEntry* LockManager::Stripe::find(int32_t employee_id, uint32_t hash) {
+        if (slots.empty()) {
+            return nullptr;
+        }
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; slots[i].occupied; i = (i + 1) & mask) {
+            if (slots[i].employee_id == employee_id) {
+                return &slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    LockManager::LockEntry& LockManager::Stripe::find_or_insert(int32_t employee_id, uint32_t hash) {
+        if (LockEntry* entry = find(employee_id, hash)) {
+            return *entry;
+        }
+        if ((used + 1) * 4 > slots.size() * 3) {
+            grow();
+        }
+
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        while (slots[i].occupied) {
+            i = (i + 1) & mask;
+        }
+        LockEntry& entry = slots[i];
+        entry.occupied = true;
+        entry.hash = hash;
+        entry.employee_id = employee_id;
+        ++used;
+        return entry;
+    }
+
+    void LockManager::Stripe::erase_if_idle(int32_t employee_id, uint32_t hash) {
+        LockEntry* entry = find(employee_id, hash);
+        if (!entry || !entry->idle()) {
+            return;
+        }
+
+        size_t mask = slots.size() - 1;
+        size_t hole = static_cast<size_t>(entry - slots.data());
+        for (size_t next = (hole + 1) & mask; slots[next].occupied; next = (next + 1) & mask) {
+            size_t home = slots[next].hash & mask;
+            bool stays = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+            if (!stays) {
+                slots[hole] = std::move(slots[next]);
+                hole = next;
+            }
+        }
+        slots[hole] = LockEntry();
+        --used;
+    }
+
+    void LockManager::Stripe::grow() {
+        std::vector<LockEntry> old;
+        old.swap(slots);
+        slots.resize(old.empty() ? INITIAL_SLOTS : old.size() * 2);
+
+        size_t mask = slots.size() - 1;
+        for (auto& entry : old) {
+            if (!entry.occupied) {
+                continue;
+            }
+            size_t i = entry.hash & mask;
+            while (slots[i].occupied) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = std::move(entry);
+        }
+    }
+
+    LockManager::LockManager(size_t stripes) : stripe_bits_(0), lease_wheel_(LEASE_TICK) {
+        while ((size_t(1) << stripe_bits_) < stripes) {
+            ++stripe_bits_;
+        }
+        stripes_.reset(new Stripe[stripe_count()]);
+        clients_.reset(new ClientStripe[CLIENT_STRIPES]);
+    }
+
+    uint32_t LockManager::mix(int32_t key) {
+        uint32_t hash = static_cast<uint32_t>(key);
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    LockManager::Stripe& LockManager::stripe_for(int32_t employee_id, uint32_t& hash) {
+        uint32_t mixed = mix(employee_id);
+        hash = mixed >> stripe_bits_;
+        return stripes_[mixed & (stripe_count() - 1)];
+    }
+
+    LockManager::ClientStripe& LockManager::client_stripe_for(int32_t client_id) {
+        return clients_[mix(client_id) % CLIENT_STRIPES];
+    }
+
+    void LockManager::track(int32_t client_id, int32_t employee_id) {
+        ClientStripe& clients = client_stripe_for(client_id);
+        std::lock_guard<std::mutex> lock(clients.mutex);
+        auto& owned = clients.owned[client_id];
+        if (std::find(owned.begin(), owned.end(), employee_id) == owned.end()) {
+            owned.push_back(employee_id);
+        }
+        renew_lease_locked(clients, client_id, Clock::now());
+    }
+
+    void LockManager::untrack_if_released(const LockEntry& entry, int32_t client_id) {
+        if (holds_lock(entry, client_id) || is_waiting(entry, client_id)) {
+            return;
+        }
+
+        ClientStripe& clients = client_stripe_for(client_id);
+        std::lock_guard<std::mutex> lock(clients.mutex);
+        auto it = clients.owned.find(client_id);
+        if (it == clients.owned.end()) {
+            return;
+        }
+        auto& owned = it->second;
+        auto pos = std::find(owned.begin(), owned.end(), entry.employee_id);
+        if (pos != owned.end()) {
+            *pos = owned.back();
+            owned.pop_back();
+        }
+    }
+
+    bool LockManager::holds_lock(const LockEntry& entry, int32_t client_id) {
+        return entry.writer == client_id || entry.has_reader(client_id);
+    }
+
+    bool LockManager::is_waiting(const LockEntry& entry, int32_t client_id) {
+        for (const auto& waiter : entry.waiters) {
+            if (waiter.client_id == client_id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool LockManager::can_grant(const LockEntry& entry, int32_t client_id, bool exclusive) {
+        if (entry.writer != NO_CLIENT && entry.writer != client_id) {
+            return false;
+        }
+
+        if (exclusive) {
+            size_t readers = entry.reader_count();
+            if (readers > 1 || (readers == 1 && !entry.has_reader(client_id))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool LockManager::try_acquire(LockEntry& entry, int32_t client_id, bool exclusive) {
+        if (!entry.waiters.empty() && !holds_lock(entry, client_id)) {
+            return false;
+        }
+        if (!can_grant(entry, client_id, exclusive)) {
             return false;
         }
-        
-        read_locks_[employee_id].insert(client_id);
+
+        if (exclusive) {
+            entry.writer = client_id;
+        } else {
+            entry.add_reader(client_id);
+        }
+        track(client_id, entry.employee_id);
         return true;
     }
-    
+
+    bool LockManager::attempt(Stripe& stripe, LockEntry& entry, int32_t client_id, bool exclusive,
+                              bool will_wait) {
+        if (try_acquire(entry, client_id, exclusive)) {
+            ++stripe.stats.acquired;
+            return true;
+        }
+        ++stripe.stats.contended;
+        if (!will_wait) {
+            ++stripe.stats.denied;
+        }
+        return false;
+    }
+
+    void LockManager::grant_waiters(Stripe& stripe, LockEntry& entry, std::vector<LockCallback>& granted) {
+        bool woke_blocked = false;
+        size_t count = 0;
+        while (count < entry.waiters.size() &&
+               can_grant(entry, entry.waiters[count].client_id, entry.waiters[count].exclusive)) {
+            Waiter& waiter = entry.waiters[count++];
+            if (waiter.exclusive) {
+                entry.writer = waiter.client_id;
+            } else {
+                entry.add_reader(waiter.client_id);
+            }
+
+            if (waiter.callback) {
+                granted.push_back(std::move(waiter.callback));
+                --stripe.async_waiters;
+            } else {
+                stripe.granted_tickets.push_back(waiter.ticket);
+                woke_blocked = true;
+            }
+        }
+
+        entry.waiters.erase(entry.waiters.begin(), entry.waiters.begin() + count);
+        stripe.stats.acquired += count;
+        if (woke_blocked) {
+            stripe.cv.notify_all();
+        }
+    }
+
+    void LockManager::notify(std::vector<LockCallback>& callbacks, bool granted) {
+        for (auto& callback : callbacks) {
+            callback(granted);
+        }
+    }
+
+    bool LockManager::acquire_read_lock(int32_t employee_id, int32_t client_id) {
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        return attempt(stripe, stripe.find_or_insert(employee_id, hash), client_id, false, false);
+    }
+
     bool LockManager::acquire_write_lock(int32_t employee_id, int32_t client_id) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        auto read_it = read_locks_.find(employee_id);
-        if (read_it != read_locks_.end()) {
-            if (read_it->second.size() > 1 || 
-                (read_it->second.size() == 1 && !read_it->second.count(client_id))) {
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        return attempt(stripe, stripe.find_or_insert(employee_id, hash), client_id, true, false);
+    }
+
+    bool LockManager::acquire_read_lock(int32_t employee_id, int32_t client_id,
+                                        std::chrono::milliseconds timeout) {
+        return acquire_blocking(employee_id, client_id, false, timeout);
+    }
+
+    bool LockManager::acquire_write_lock(int32_t employee_id, int32_t client_id,
+                                         std::chrono::milliseconds timeout) {
+        return acquire_blocking(employee_id, client_id, true, timeout);
+    }
+
+    bool LockManager::acquire_blocking(int32_t employee_id, int32_t client_id, bool exclusive,
+                                       std::chrono::milliseconds timeout) {
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::unique_lock<std::mutex> lock(stripe.mutex);
+        LockEntry& entry = stripe.find_or_insert(employee_id, hash);
+        if (attempt(stripe, entry, client_id, exclusive, timeout.count() > 0)) {
+            return true;
+        }
+        if (timeout.count() <= 0) {
+            return false;
+        }
+
+        uint64_t ticket = ++next_ticket_;
+        auto deadline = Clock::now() + timeout;
+        entry.waiters.push_back(Waiter{client_id, exclusive, deadline, ticket, nullptr});
+        track(client_id, employee_id);
+
+        auto is_granted = [&stripe, ticket] {
+            auto it = std::find(stripe.granted_tickets.begin(), stripe.granted_tickets.end(), ticket);
+            if (it == stripe.granted_tickets.end()) {
                 return false;
             }
+            stripe.granted_tickets.erase(it);
+            return true;
+        };
+        if (stripe.cv.wait_until(lock, deadline, is_granted)) {
+            return true;
         }
-        
-        auto write_it = write_locks_.find(employee_id);
-        if (write_it != write_locks_.end() && write_it->second != client_id) {
-            return false;
+
+        ++stripe.stats.timed_out;
+        std::vector<LockCallback> granted;
+        if (LockEntry* current = stripe.find(employee_id, hash)) {
+            auto& waiters = current->waiters;
+            waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                         [ticket](const Waiter& w) { return w.ticket == ticket; }),
+                          waiters.end());
+            grant_waiters(stripe, *current, granted);
+            untrack_if_released(*current, client_id);
+            stripe.erase_if_idle(employee_id, hash);
         }
-        
-        write_locks_[employee_id] = client_id;
-        return true;
+        lock.unlock();
+        notify(granted, true);
+        return false;
+    }
+
+    void LockManager::acquire_lock_async(int32_t employee_id, int32_t client_id, bool exclusive,
+                                         std::chrono::milliseconds timeout, LockCallback callback) {
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        bool acquired;
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            LockEntry& entry = stripe.find_or_insert(employee_id, hash);
+            acquired = attempt(stripe, entry, client_id, exclusive, timeout.count() > 0);
+            if (!acquired && timeout.count() > 0) {
+                entry.waiters.push_back(
+                    Waiter{client_id, exclusive, Clock::now() + timeout, ++next_ticket_, std::move(callback)});
+                ++stripe.async_waiters;
+                track(client_id, employee_id);
+                queued = true;
+            }
+        }
+
+        if (!queued) {
+            callback(acquired);
+            return;
+        }
+
+        std::function<void()> listener;
+        {
+            std::lock_guard<std::mutex> lock(listener_mutex_);
+            listener = waiter_listener_;
+        }
+        if (listener) {
+            listener();
+        }
+    }
+
+    size_t LockManager::expire_waiters(Clock::time_point now) {
+        std::vector<LockCallback> expired;
+        std::vector<LockCallback> granted;
+        std::vector<std::pair<int32_t, uint32_t>> touched;
+        std::vector<int32_t> expired_clients;
+
+        for (size_t s = 0; s < stripe_count(); ++s) {
+            Stripe& stripe = stripes_[s];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            if (stripe.async_waiters == 0) {
+                continue;
+            }
+
+            touched.clear();
+            for (auto& entry : stripe.slots) {
+                if (!entry.occupied || entry.waiters.empty()) {
+                    continue;
+                }
+
+                expired_clients.clear();
+                auto& waiters = entry.waiters;
+                for (auto waiter = waiters.begin(); waiter != waiters.end(); ) {
+                    if (waiter->callback && waiter->deadline <= now) {
+                        expired.push_back(std::move(waiter->callback));
+                        expired_clients.push_back(waiter->client_id);
+                        --stripe.async_waiters;
+                        ++stripe.stats.timed_out;
+                        waiter = waiters.erase(waiter);
+                    } else {
+                        ++waiter;
+                    }
+                }
+                if (!expired_clients.empty()) {
+                    grant_waiters(stripe, entry, granted);
+                    for (int32_t client_id : expired_clients) {
+                        untrack_if_released(entry, client_id);
+                    }
+                    touched.emplace_back(entry.employee_id, entry.hash);
+                }
+            }
+            for (const auto& key : touched) {
+                stripe.erase_if_idle(key.first, key.second);
+            }
+        }
+
+        notify(expired, false);
+        notify(granted, true);
+        return expired.size();
+    }
+
+    bool LockManager::next_waiter_deadline(Clock::time_point& deadline) {
+        bool found = false;
+        for (size_t s = 0; s < stripe_count(); ++s) {
+            Stripe& stripe = stripes_[s];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            if (stripe.async_waiters == 0) {
+                continue;
+            }
+            for (const auto& entry : stripe.slots) {
+                for (const auto& waiter : entry.waiters) {
+                    if (waiter.callback && (!found || waiter.deadline < deadline)) {
+                        deadline = waiter.deadline;
+                        found = true;
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    void LockManager::set_waiter_listener(std::function<void()> listener) {
+        std::lock_guard<std::mutex> lock(listener_mutex_);
+        waiter_listener_ = std::move(listener);
     }
-    
+
     void LockManager::release_read_lock(int32_t employee_id, int32_t client_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = read_locks_.find(employee_id);
-        if (it != read_locks_.end()) {
-            it->second.erase(client_id);
-            if (it->second.empty()) {
-                read_locks_.erase(it);
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::vector<LockCallback> granted;
+        {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            LockEntry* entry = stripe.find(employee_id, hash);
+            if (!entry) {
+                return;
             }
+            entry->remove_reader(client_id);
+            grant_waiters(stripe, *entry, granted);
+            untrack_if_released(*entry, client_id);
+            stripe.erase_if_idle(employee_id, hash);
         }
-        cv_.notify_all();
+        notify(granted, true);
     }
-    
+
     void LockManager::release_write_lock(int32_t employee_id, int32_t client_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = write_locks_.find(employee_id);
-        if (it != write_locks_.end() && it->second == client_id) {
-            write_locks_.erase(it);
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::vector<LockCallback> granted;
+        {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            LockEntry* entry = stripe.find(employee_id, hash);
+            if (!entry) {
+                return;
+            }
+            if (entry->writer == client_id) {
+                entry->writer = NO_CLIENT;
+            }
+            grant_waiters(stripe, *entry, granted);
+            untrack_if_released(*entry, client_id);
+            stripe.erase_if_idle(employee_id, hash);
         }
-        cv_.notify_all();
+        notify(granted, true);
     }
-    
+
     void LockManager::release_all_locks(int32_t client_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        for (auto it = read_locks_.begin(); it != read_locks_.end(); ) {
-            it->second.erase(client_id);
-            if (it->second.empty()) {
-                it = read_locks_.erase(it);
-            } else {
-                ++it;
+        release_locks_if(client_id, nullptr);
+    }
+
+    void LockManager::release_locks_if(int32_t client_id, const std::function<bool(int32_t)>& selected) {
+        std::vector<int32_t> owned;
+        {
+            ClientStripe& clients = client_stripe_for(client_id);
+            std::lock_guard<std::mutex> lock(clients.mutex);
+            auto it = clients.owned.find(client_id);
+            if (it == clients.owned.end()) {
+                return;
+            }
+            std::vector<int32_t>& ids = it->second;
+            auto kept = selected ? std::partition(ids.begin(), ids.end(),
+                                                  [&selected](int32_t id) { return !selected(id); })
+                                 : ids.begin();
+            owned.assign(kept, ids.end());
+            ids.erase(kept, ids.end());
+            if (ids.empty()) {
+                clients.owned.erase(it);
             }
         }
-        
-        for (auto it = write_locks_.begin(); it != write_locks_.end(); ) {
-            if (it->second == client_id) {
-                it = write_locks_.erase(it);
-            } else {
-                ++it;
+
+        std::vector<LockCallback> cancelled;
+        std::vector<LockCallback> granted;
+        for (int32_t employee_id : owned) {
+            uint32_t hash;
+            Stripe& stripe = stripe_for(employee_id, hash);
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            LockEntry* entry = stripe.find(employee_id, hash);
+            if (!entry) {
+                continue;
+            }
+
+            if (entry->writer == client_id) {
+                entry->writer = NO_CLIENT;
+            }
+            entry->remove_reader(client_id);
+
+            auto& waiters = entry->waiters;
+            for (auto waiter = waiters.begin(); waiter != waiters.end(); ) {
+                if (waiter->client_id == client_id && waiter->callback) {
+                    cancelled.push_back(std::move(waiter->callback));
+                    --stripe.async_waiters;
+                    waiter = waiters.erase(waiter);
+                } else {
+                    ++waiter;
+                }
             }
+
+            grant_waiters(stripe, *entry, granted);
+            if (holds_lock(*entry, client_id) || is_waiting(*entry, client_id)) {
+                track(client_id, employee_id);
+            }
+            stripe.erase_if_idle(employee_id, hash);
+        }
+
+        notify(cancelled, false);
+        notify(granted, true);
+    }
+
+    bool LockManager::is_held_by(int32_t employee_id, int32_t client_id, bool exclusive) {
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        LockEntry* entry = stripe.find(employee_id, hash);
+        if (!entry) {
+            return false;
+        }
+        return exclusive ? entry->writer == client_id : holds_lock(*entry, client_id);
+    }
+
+    bool LockManager::is_locked_by_others(int32_t employee_id, int32_t client_id) {
+        uint32_t hash;
+        Stripe& stripe = stripe_for(employee_id, hash);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        LockEntry* entry = stripe.find(employee_id, hash);
+        if (!entry) {
+            return false;
+        }
+        if (entry->writer != NO_CLIENT && entry->writer != client_id) {
+            return true;
+        }
+        return entry->reader_count() > (entry->has_reader(client_id) ? 1u : 0u);
+    }
+
+    size_t LockManager::owned_lock_count(int32_t client_id) {
+        ClientStripe& clients = client_stripe_for(client_id);
+        std::lock_guard<std::mutex> lock(clients.mutex);
+        auto it = clients.owned.find(client_id);
+        return it == clients.owned.end() ? 0 : it->second.size();
+    }
+
+    void LockManager::set_lease_duration(std::chrono::milliseconds duration) {
+        lease_duration_ = duration;
+        if (duration.count() > 0) {
+            return;
+        }
+        for (size_t c = 0; c < CLIENT_STRIPES; ++c) {
+            std::lock_guard<std::mutex> lock(clients_[c].mutex);
+            clients_[c].leases.clear();
+        }
+    }
+
+    void LockManager::renew_lease(int32_t client_id, Clock::time_point now) {
+        ClientStripe& clients = client_stripe_for(client_id);
+        std::lock_guard<std::mutex> lock(clients.mutex);
+        renew_lease_locked(clients, client_id, now);
+    }
+
+    void LockManager::renew_lease_locked(ClientStripe& clients, int32_t client_id, Clock::time_point now) {
+        std::chrono::milliseconds duration = lease_duration_;
+        if (duration.count() <= 0) {
+            return;
+        }
+
+        auto deadline = now + duration;
+        auto it = clients.leases.find(client_id);
+        if (it != clients.leases.end()) {
+            it->second = std::max(it->second, deadline);
+            return;
+        }
+        clients.leases.emplace(client_id, deadline);
+        std::lock_guard<std::mutex> lock(lease_mutex_);
+        lease_wheel_.schedule(client_id, deadline);
+    }
+
+    std::vector<int32_t> LockManager::expire_leases(Clock::time_point now) {
+        std::vector<int32_t> due;
+        {
+            std::lock_guard<std::mutex> lock(lease_mutex_);
+            lease_wheel_.advance(now, due);
+        }
+
+        std::vector<int32_t> expired;
+        for (int32_t client_id : due) {
+            ClientStripe& clients = client_stripe_for(client_id);
+            std::lock_guard<std::mutex> lock(clients.mutex);
+            auto it = clients.leases.find(client_id);
+            if (it == clients.leases.end()) {
+                continue;
+            }
+            if (it->second > now) {
+                std::lock_guard<std::mutex> wheel_lock(lease_mutex_);
+                lease_wheel_.schedule(client_id, it->second);
+                continue;
+            }
+            clients.leases.erase(it);
+            expired.push_back(client_id);
+        }
+
+        std::vector<int32_t> reclaimed;
+        for (int32_t client_id : expired) {
+            if (owned_lock_count(client_id) > 0) {
+                release_all_locks(client_id);
+                reclaimed.push_back(client_id);
+            }
+        }
+        return reclaimed;
+    }
+
+    size_t LockManager::lease_count() {
+        size_t count = 0;
+        for (size_t c = 0; c < CLIENT_STRIPES; ++c) {
+            std::lock_guard<std::mutex> lock(clients_[c].mutex);
+            count += clients_[c].leases.size();
+        }
+        return count;
+    }
+
+    LockManager::LockStats LockManager::stats() {
+        LockStats total;
+        for (size_t s = 0; s < stripe_count(); ++s) {
+            Stripe& stripe = stripes_[s];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            total.acquired += stripe.stats.acquired;
+            total.contended += stripe.stats.contended;
+            total.denied += stripe.stats.denied;
+            total.timed_out += stripe.stats.timed_out;
         }
-        
-        cv_.notify_all();
+        return total;
     }
 
-} 
\ No newline at end of file
+}
@@ -0,0 +1,514 @@
+#include "log_store.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EmployeeSystem {
+
+    namespace {
+
+        bool read_exact(int fd, void* data, size_t size, off_t offset) {
+            char* ptr = static_cast<char*>(data);
+            while (size > 0) {
+                ssize_t n = ::pread(fd, ptr, size, offset);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+                offset += n;
+            }
+            return true;
+        }
+
+        bool write_exact(int fd, const void* data, size_t size, off_t offset) {
+            const char* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+                ssize_t n = ::pwrite(fd, ptr, size, offset);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+                offset += n;
+            }
+            return true;
+        }
+
+        off_t record_offset(size_t index) {
+            return static_cast<off_t>(index * sizeof(LogRecord));
+        }
+
+        bool sync_fd(int fd) {
+#ifdef __linux__
+            return ::fdatasync(fd) == 0;
+#else
+            return ::fsync(fd) == 0;
+#endif
+        }
+
+        constexpr size_t CHUNK_RECORDS = 4096;
+        constexpr const char* SEGMENT_SUFFIX = ".seg";
+
+    }
+
+    LogStore::Segment::Segment(uint32_t segment_id, int segment_fd, const std::string& segment_path)
+        : id(segment_id), fd(segment_fd), path(segment_path), records(0), live(0) {}
+
+    LogStore::Segment::~Segment() {
+        ::close(fd);
+    }
+
+    LogStore::LogStore(const std::string& base, size_t segment_records, bool sync_appends)
+        : base_(base), segment_records_(std::max<size_t>(segment_records, 1)), sync_appends_(sync_appends),
+          next_seq_(1), next_segment_(1), open_(false), stopping_(false), pending_compaction_(false) {}
+
+    uint32_t LogStore::checksum(const LogRecord& record) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < offsetof(LogRecord, checksum); ++i) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    std::string LogStore::segment_path(uint32_t id) const {
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), ".%06u%s", id, SEGMENT_SUFFIX);
+        return base_ + suffix;
+    }
+
+    std::vector<uint32_t> LogStore::list_segments() const {
+        size_t slash = base_.rfind('/');
+        std::string dir = slash == std::string::npos ? "." : base_.substr(0, slash + 1);
+        std::string prefix = (slash == std::string::npos ? base_ : base_.substr(slash + 1)) + ".";
+        std::string suffix = SEGMENT_SUFFIX;
+
+        std::vector<uint32_t> ids;
+        DIR* handle = ::opendir(dir.c_str());
+        if (!handle) {
+            return ids;
+        }
+        while (struct dirent* entry = ::readdir(handle)) {
+            std::string name = entry->d_name;
+            if (name.size() <= prefix.size() + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+                name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                continue;
+            }
+            std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+            if (std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                ids.push_back(static_cast<uint32_t>(std::strtoul(digits.c_str(), nullptr, 10)));
+            }
+        }
+        ::closedir(handle);
+
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::shared_ptr<LogStore::Segment> LogStore::create_segment(uint32_t id) {
+        std::string path = segment_path(id);
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return nullptr;
+        }
+        return std::make_shared<Segment>(id, fd, path);
+    }
+
+    bool LogStore::load_segment(uint32_t id, std::vector<uint64_t>& seqs) {
+        std::string path = segment_path(id);
+        int fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) {
+            return false;
+        }
+        auto segment = std::make_shared<Segment>(id, fd, path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            return false;
+        }
+        size_t total = static_cast<size_t>(st.st_size) / sizeof(LogRecord);
+        bool corrupt = false;
+
+        std::vector<LogRecord> chunk(std::min(total, CHUNK_RECORDS));
+        for (size_t first = 0; first < total && !corrupt; first += CHUNK_RECORDS) {
+            size_t count = std::min(CHUNK_RECORDS, total - first);
+            if (!read_exact(fd, chunk.data(), count * sizeof(LogRecord), record_offset(first))) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                const LogRecord& record = chunk[i];
+                if (record.checksum != checksum(record)) {
+                    corrupt = true;
+                    break;
+                }
+                if (record.slot >= locations_.size()) {
+                    locations_.resize(record.slot + 1);
+                    seqs.resize(record.slot + 1, 0);
+                }
+                if (record.seq > seqs[record.slot]) {
+                    seqs[record.slot] = record.seq;
+                    locations_[record.slot] = Location{id, static_cast<uint32_t>(segment->records)};
+                }
+                next_seq_ = std::max(next_seq_, record.seq + 1);
+                ++segment->records;
+            }
+        }
+
+        if (record_offset(segment->records) != st.st_size && ::ftruncate(fd, record_offset(segment->records)) != 0) {
+            return false;
+        }
+        segments_.emplace(id, segment);
+        return true;
+    }
+
+    bool LogStore::open() {
+        close();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<uint64_t> seqs;
+            for (uint32_t id : list_segments()) {
+                if (!load_segment(id, seqs)) {
+                    segments_.clear();
+                    locations_.clear();
+                    return false;
+                }
+                next_segment_ = std::max(next_segment_, id + 1);
+            }
+
+            for (const Location& location : locations_) {
+                if (location.segment != 0) {
+                    ++segments_[location.segment]->live;
+                }
+            }
+            for (auto it = segments_.begin(); it != segments_.end();) {
+                if (it->second->live == 0) {
+                    ::unlink(it->second->path.c_str());
+                    it = segments_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            open_ = true;
+            stopping_ = false;
+            pending_compaction_ = true;
+        }
+        compactor_ = std::thread(&LogStore::compactor_loop, this);
+        return true;
+    }
+
+    bool LogStore::is_open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return open_;
+    }
+
+    size_t LogStore::slot_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return locations_.size();
+    }
+
+    bool LogStore::read(size_t slot, Employee& employee) {
+        std::shared_ptr<Segment> segment;
+        Location location;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (slot >= locations_.size()) {
+                return false;
+            }
+            location = locations_[slot];
+            if (location.segment == 0) {
+                employee = Employee();
+                employee.id = TOMBSTONE_ID;
+                return true;
+            }
+            segment = segments_[location.segment];
+        }
+
+        LogRecord record;
+        if (!read_exact(segment->fd, &record, sizeof(LogRecord), record_offset(location.index))) {
+            return false;
+        }
+        employee = record.employee;
+        return true;
+    }
+
+    bool LogStore::roll_locked() {
+        if (active_) {
+            if (!sync_fd(active_->fd)) {
+                return false;
+            }
+            pending_compaction_ = true;
+            cv_.notify_one();
+        }
+
+        auto segment = create_segment(next_segment_++);
+        if (!segment) {
+            return false;
+        }
+        segments_.emplace(segment->id, segment);
+        active_ = segment;
+        return true;
+    }
+
+    bool LogStore::append(size_t slot, const Employee& employee) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ((!active_ || active_->records >= segment_records_) && !roll_locked()) {
+            return false;
+        }
+
+        LogRecord record;
+        record.seq = next_seq_++;
+        record.slot = slot;
+        record.employee = employee;
+        record.checksum = checksum(record);
+        if (!write_exact(active_->fd, &record, sizeof(LogRecord), record_offset(active_->records))) {
+            return false;
+        }
+        if (sync_appends_ && !sync_fd(active_->fd)) {
+            return false;
+        }
+
+        if (slot >= locations_.size()) {
+            locations_.resize(slot + 1);
+        }
+        Location& location = locations_[slot];
+        if (location.segment != 0) {
+            --segments_[location.segment]->live;
+        }
+        location = Location{active_->id, static_cast<uint32_t>(active_->records)};
+        ++active_->records;
+        ++active_->live;
+        return true;
+    }
+
+    bool LogStore::sync() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !active_ || sync_fd(active_->fd);
+    }
+
+    bool LogStore::compact_once() {
+        std::vector<std::shared_ptr<Segment>> victims;
+        std::vector<std::pair<size_t, Location>> moved;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& entry : segments_) {
+                const auto& segment = entry.second;
+                if (segment != active_ && segment->live * 2 <= segment->records) {
+                    victims.push_back(segment);
+                }
+            }
+            if (victims.empty()) {
+                return true;
+            }
+
+            std::vector<uint32_t> victim_ids;
+            for (const auto& victim : victims) {
+                victim_ids.push_back(victim->id);
+            }
+            for (size_t slot = 0; slot < locations_.size(); ++slot) {
+                const Location& location = locations_[slot];
+                if (location.segment != 0 &&
+                    std::binary_search(victim_ids.begin(), victim_ids.end(), location.segment)) {
+                    moved.emplace_back(slot, location);
+                }
+            }
+        }
+
+        std::sort(moved.begin(), moved.end(), [](const auto& a, const auto& b) {
+            return a.second.segment != b.second.segment ? a.second.segment < b.second.segment
+                                                        : a.second.index < b.second.index;
+        });
+
+        std::vector<std::shared_ptr<Segment>> outputs;
+        std::vector<LogRecord> source;
+        std::vector<LogRecord> pending;
+
+        auto discard = [&outputs]() {
+            for (const auto& output : outputs) {
+                ::unlink(output->path.c_str());
+            }
+            return false;
+        };
+        auto emit = [&]() {
+            if (pending.empty()) {
+                return true;
+            }
+            uint32_t id;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                id = next_segment_++;
+            }
+            auto output = create_segment(id);
+            if (!output) {
+                return false;
+            }
+            outputs.push_back(output);
+            output->records = pending.size();
+            bool written = write_exact(output->fd, pending.data(), pending.size() * sizeof(LogRecord), 0) &&
+                           sync_fd(output->fd);
+            pending.clear();
+            return written;
+        };
+
+        size_t next = 0;
+        for (const auto& victim : victims) {
+            source.resize(victim->records);
+            if (!source.empty() &&
+                !read_exact(victim->fd, source.data(), source.size() * sizeof(LogRecord), 0)) {
+                return discard();
+            }
+            for (; next < moved.size() && moved[next].second.segment == victim->id; ++next) {
+                pending.push_back(source[moved[next].second.index]);
+                if (pending.size() >= segment_records_ && !emit()) {
+                    return discard();
+                }
+            }
+        }
+        if (!emit()) {
+            return discard();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < moved.size(); ++i) {
+                const auto& output = outputs[i / segment_records_];
+                Location& location = locations_[moved[i].first];
+                if (location == moved[i].second) {
+                    location = Location{output->id, static_cast<uint32_t>(i % segment_records_)};
+                    ++output->live;
+                }
+            }
+            for (const auto& segment : outputs) {
+                segments_.emplace(segment->id, segment);
+            }
+
+            size_t dropped = 0;
+            for (const auto& victim : victims) {
+                dropped += victim->records;
+                segments_.erase(victim->id);
+            }
+            stats_.reclaimed += dropped - moved.size();
+            ++stats_.compactions;
+        }
+
+        for (const auto& victim : victims) {
+            ::unlink(victim->path.c_str());
+        }
+        return true;
+    }
+
+    bool LogStore::compact() {
+        std::lock_guard<std::mutex> guard(compaction_mutex_);
+        return compact_once();
+    }
+
+    void LogStore::compactor_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] { return stopping_ || pending_compaction_; });
+            if (stopping_) {
+                return;
+            }
+            pending_compaction_ = false;
+            lock.unlock();
+            compact();
+            lock.lock();
+        }
+    }
+
+    void LogStore::stop_compactor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (compactor_.joinable()) {
+            compactor_.join();
+        }
+    }
+
+    bool LogStore::reset(const std::vector<Employee>& employees) {
+        if (!is_open() && !open()) {
+            return false;
+        }
+        stop_compactor();
+
+        std::lock_guard<std::mutex> guard(compaction_mutex_);
+        std::vector<std::string> stale;
+        uint32_t first_new;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& entry : segments_) {
+                stale.push_back(entry.second->path);
+            }
+            segments_.clear();
+            locations_.clear();
+            active_.reset();
+            first_new = next_segment_;
+        }
+
+        bool written = true;
+        for (size_t slot = 0; slot < employees.size() && written; ++slot) {
+            written = append(slot, employees[slot]);
+        }
+        written = written && sync();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (written) {
+            for (const std::string& path : stale) {
+                ::unlink(path.c_str());
+            }
+        } else {
+            for (uint32_t id = first_new; id < next_segment_; ++id) {
+                ::unlink(segment_path(id).c_str());
+            }
+        }
+        segments_.clear();
+        locations_.clear();
+        active_.reset();
+        open_ = false;
+        return written;
+    }
+
+    LogStore::Stats LogStore::stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.segments = segments_.size();
+        for (const auto& entry : segments_) {
+            stats.records += entry.second->records;
+            stats.live += entry.second->live;
+        }
+        return stats;
+    }
+
+    void LogStore::close() {
+        stop_compactor();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (active_) {
+            sync_fd(active_->fd);
+        }
+        segments_.clear();
+        locations_.clear();
+        active_.reset();
+        open_ = false;
+    }
+
+    LogStore::~LogStore() {
+        close();
+    }
+
+}
@@ -1,21 +1,187 @@
 #include "logger.h"
-#include <iomanip>
+#include "mpsc_queue.h"
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <thread>
 
 namespace EmployeeSystem {
 
+    namespace {
+
+        constexpr size_t MAX_BATCH = 256;
+        constexpr auto IDLE_WAIT = std::chrono::milliseconds(20);
+
+        const char* time_prefix() {
+            thread_local std::time_t cached_second = -1;
+            thread_local char cached[32];
+
+            std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            if (now != cached_second) {
+                std::tm local_time;
+                localtime_r(&now, &local_time);
+                strftime(cached, sizeof(cached), "[%Y-%m-%d %H:%M:%S] ", &local_time);
+                cached_second = now;
+            }
+            return cached;
+        }
+
+        class LogBackend {
+        private:
+            MpscQueue<std::string> queue_;
+            std::thread thread_;
+            std::atomic<bool> running_;
+            std::atomic<bool> sleeping_;
+            std::atomic<size_t> pushed_;
+            std::atomic<size_t> written_;
+            std::atomic<size_t> dropped_;
+            size_t dropped_reported_;
+            std::mutex wake_mutex_;
+            std::condition_variable wake_;
+            std::condition_variable drained_;
+            std::mutex output_mutex_;
+            std::ostream* out_;
+
+            void drain() {
+                std::string batch;
+                std::string line;
+                while (true) {
+                    batch.clear();
+                    size_t count = 0;
+                    while (count < MAX_BATCH && queue_.try_pop(line)) {
+                        batch += line;
+                        ++count;
+                    }
+
+                    size_t dropped = dropped_.load();
+                    if (dropped != dropped_reported_) {
+                        batch += std::string(time_prefix()) + "[WARN] " +
+                                 std::to_string(dropped - dropped_reported_) + " log records dropped\n";
+                        dropped_reported_ = dropped;
+                    }
+                    if (batch.empty()) {
+                        return;
+                    }
+
+                    write(batch);
+                    written_.fetch_add(count);
+                    drained_.notify_all();
+                }
+            }
+
+            void run() {
+                while (running_) {
+                    drain();
+                    std::unique_lock<std::mutex> lock(wake_mutex_);
+                    sleeping_ = true;
+                    wake_.wait_for(lock, IDLE_WAIT, [this]() { return !running_ || !queue_.empty(); });
+                    sleeping_ = false;
+                }
+                drain();
+            }
+
+        public:
+            LogBackend()
+                : queue_(Logger::ASYNC_QUEUE_CAPACITY), running_(false), sleeping_(false), pushed_(0),
+                  written_(0), dropped_(0), dropped_reported_(0), out_(&std::cout) {}
+
+            ~LogBackend() {
+                stop();
+            }
+
+            bool running() const {
+                return running_.load(std::memory_order_relaxed);
+            }
+
+            void push(std::string&& line) {
+                if (!queue_.try_push(std::move(line))) {
+                    dropped_.fetch_add(1);
+                    return;
+                }
+                pushed_.fetch_add(1);
+                if (sleeping_.load()) {
+                    wake_.notify_one();
+                }
+            }
+
+            void write(const std::string& text) {
+                std::lock_guard<std::mutex> lock(output_mutex_);
+                *out_ << text << std::flush;
+            }
+
+            void start() {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                if (running_) {
+                    return;
+                }
+                running_ = true;
+                thread_ = std::thread([this]() { run(); });
+            }
+
+            void stop() {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex_);
+                    if (!running_) {
+                        return;
+                    }
+                    running_ = false;
+                }
+                wake_.notify_one();
+                thread_.join();
+                drain();
+            }
+
+            void flush() {
+                size_t target = pushed_.load();
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                while (running_ && written_.load() < target) {
+                    wake_.notify_one();
+                    drained_.wait_for(lock, IDLE_WAIT);
+                }
+            }
+
+            void set_output(std::ostream* out) {
+                std::lock_guard<std::mutex> lock(output_mutex_);
+                out_ = out ? out : &std::cout;
+            }
+
+            size_t dropped() const {
+                return dropped_.load();
+            }
+        };
+
+        LogBackend& backend() {
+            static LogBackend instance;
+            return instance;
+        }
+
+    }
+
     const char* Logger::levelToString(Level level) {
         static const char* level_str[] = {"DEBUG", "INFO", "WARN", "ERROR"};
         return level_str[static_cast<int>(level)];
     }
 
     void Logger::log(Level level, const std::string& message) {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
+        if (!enabled(level)) {
+            return;
+        }
         
-        std::cout << "[" << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S") << "] "
-                  << "[" << levelToString(level) << "] " 
-                  << message << std::endl;
+        std::string line = time_prefix();
+        line += '[';
+        line += levelToString(level);
+        line += "] ";
+        line += message;
+        line += '\n';
+
+        LogBackend& sink = backend();
+        if (sink.running()) {
+            sink.push(std::move(line));
+        } else {
+            sink.write(line);
+        }
     }
 
     void Logger::debug(const std::string& message) { log(Level::DEBUG, message); }
@@ -23,4 +189,36 @@ namespace EmployeeSystem {
     void Logger::warn(const std::string& message) { log(Level::WARN, message); }
     void Logger::error(const std::string& message) { log(Level::ERROR, message); }
 
-} 
\ No newline at end of file
+    void Logger::set_async(bool enabled) {
+        if (enabled) {
+            backend().start();
+        } else {
+            backend().stop();
+        }
+    }
+
+    bool Logger::is_async() { return backend().running(); }
+    void Logger::flush() { backend().flush(); }
+    void Logger::set_output(std::ostream* out) { backend().set_output(out); }
+    size_t Logger::dropped() { return backend().dropped(); }
+
+    void Logger::set_level(Level level) {
+        threshold_.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    Logger::Level Logger::level() {
+        return static_cast<Level>(threshold_.load(std::memory_order_relaxed));
+    }
+
+    bool Logger::parse_level(const std::string& name, Level& level) {
+        static const char* names[] = {"debug", "info", "warn", "error"};
+        for (int i = 0; i < 4; ++i) {
+            if (name == names[i]) {
+                level = static_cast<Level>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,172 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace EmployeeSystem {
+
+    LatencyHistogram::LatencyHistogram() : count_(0), sum_(0), max_(0) {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    size_t LatencyHistogram::bucket_for(uint64_t micros) {
+        if (micros < SUB_BUCKETS) {
+            return static_cast<size_t>(micros);
+        }
+        size_t msb = 63 - static_cast<size_t>(__builtin_clzll(micros));
+        size_t shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((micros >> shift) - SUB_BUCKETS);
+    }
+
+    uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        size_t shift = index / SUB_BUCKETS - 1;
+        uint64_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(uint64_t micros) {
+        buckets_[bucket_for(micros)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(micros, std::memory_order_relaxed);
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        while (micros > current && !max_.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    void LatencyHistogram::record(std::chrono::steady_clock::duration elapsed) {
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        record(static_cast<uint64_t>(micros > 0 ? micros : 0));
+    }
+
+    double LatencyHistogram::mean() const {
+        uint64_t total = count();
+        return total == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / total;
+    }
+
+    uint64_t LatencyHistogram::percentile(double fraction) const {
+        uint64_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(std::ceil(fraction * total));
+        target = std::max<uint64_t>(1, std::min(target, total));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                return std::min(bucket_upper_bound(i), max());
+            }
+        }
+        return max();
+    }
+
+    void LatencyHistogram::reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    int ServerMetrics::index_of(OperationType operation) {
+        for (size_t i = 0; i < OPERATIONS; ++i) {
+            if (TRACKED[i] == operation) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    const char* ServerMetrics::operation_name(OperationType operation) {
+        switch (operation) {
+            case OperationType::READ: return "READ";
+            case OperationType::PEEK: return "PEEK";
+            case OperationType::WRITE: return "WRITE";
+            case OperationType::UNLOCK: return "UNLOCK";
+            case OperationType::EXIT: return "EXIT";
+            case OperationType::BATCH_READ: return "BATCH_READ";
+            case OperationType::BATCH_WRITE: return "BATCH_WRITE";
+            case OperationType::COMPARE_AND_SET: return "CAS";
+            case OperationType::ATOMIC: return "ATOMIC";
+            case OperationType::INSERT: return "INSERT";
+            case OperationType::DELETE: return "DELETE";
+            case OperationType::QUERY_NAME: return "QUERY_NAME";
+            case OperationType::SCAN: return "SCAN";
+            case OperationType::AGGREGATE: return "AGGREGATE";
+            default: return "OTHER";
+        }
+    }
+
+    const char* ServerMetrics::phase_name(Phase phase) {
+        static const char* names[] = {"queue_wait", "lock_wait", "io", "total"};
+        return names[static_cast<int>(phase)];
+    }
+
+    void ServerMetrics::record(OperationType operation, Phase phase, Clock::duration elapsed) {
+        int index = index_of(operation);
+        if (index >= 0) {
+            histograms_[index][static_cast<size_t>(phase)].record(elapsed);
+        }
+    }
+
+    const LatencyHistogram* ServerMetrics::histogram(OperationType operation, Phase phase) const {
+        int index = index_of(operation);
+        return index < 0 ? nullptr : &histograms_[index][static_cast<size_t>(phase)];
+    }
+
+    std::string ServerMetrics::report(const LockManager::LockStats& locks, const RecordCache::Stats& cache) const {
+        std::ostringstream out;
+        char line[256];
+        for (size_t op = 0; op < OPERATIONS; ++op) {
+            for (size_t phase = 0; phase < PHASES; ++phase) {
+                const LatencyHistogram& histogram = histograms_[op][phase];
+                if (histogram.count() == 0) {
+                    continue;
+                }
+                snprintf(line, sizeof(line),
+                         "%-11s %-10s count=%llu mean=%.1fus p50=%lluus p90=%lluus p99=%lluus max=%lluus\n",
+                         operation_name(TRACKED[op]), phase_name(static_cast<Phase>(phase)),
+                         static_cast<unsigned long long>(histogram.count()), histogram.mean(),
+                         static_cast<unsigned long long>(histogram.percentile(0.50)),
+                         static_cast<unsigned long long>(histogram.percentile(0.90)),
+                         static_cast<unsigned long long>(histogram.percentile(0.99)),
+                         static_cast<unsigned long long>(histogram.max()));
+                out << line;
+            }
+        }
+        out << "locks acquired=" << locks.acquired << " contended=" << locks.contended
+            << " denied=" << locks.denied << " timed_out=" << locks.timed_out << "\n";
+        if (cache.capacity > 0) {
+            out << "cache hits=" << cache.hits << " misses=" << cache.misses << " evictions=" << cache.evictions
+                << " write_backs=" << cache.write_backs << " size=" << cache.size << "/" << cache.capacity
+                << " dirty=" << cache.dirty << "\n";
+        }
+        return out.str();
+    }
+
+    bool ServerMetrics::dump(const std::string& path, const LockManager::LockStats& locks,
+                             const RecordCache::Stats& cache) const {
+        std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            file << report(locks, cache);
+            if (!file) {
+                return false;
+            }
+        }
+        return std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+
+}
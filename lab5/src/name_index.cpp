@@ -0,0 +1,49 @@
+#include "name_index.h"
+
+namespace EmployeeSystem {
+
+    std::string NameIndex::key(const char* name) {
+        return std::string(name, strnlen(name, sizeof(Employee::name)));
+    }
+
+    void NameIndex::put(int32_t id, const char* name) {
+        std::string value = key(name);
+        auto it = names_.find(id);
+        if (it != names_.end()) {
+            if (it->second == value) {
+                return;
+            }
+            entries_.erase({it->second, id});
+            it->second = value;
+        } else {
+            names_.emplace(id, value);
+        }
+        entries_.emplace(std::move(value), id);
+    }
+
+    void NameIndex::erase(int32_t id) {
+        auto it = names_.find(id);
+        if (it == names_.end()) {
+            return;
+        }
+        entries_.erase({it->second, id});
+        names_.erase(it);
+    }
+
+    void NameIndex::clear() {
+        entries_.clear();
+        names_.clear();
+    }
+
+    std::vector<int32_t> NameIndex::find(const std::string& name, bool prefix, size_t limit) const {
+        std::vector<int32_t> ids;
+        for (auto it = entries_.lower_bound({name, INT32_MIN}); it != entries_.end() && ids.size() < limit; ++it) {
+            if (prefix ? it->first.compare(0, name.size(), name) != 0 : it->first != name) {
+                break;
+            }
+            ids.push_back(it->second);
+        }
+        return ids;
+    }
+
+}
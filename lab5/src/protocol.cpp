@@ -0,0 +1,69 @@
+#include "protocol.h"
+
+namespace EmployeeSystem {
+
+    bool encode_request(const Request& header, const void* payload, size_t payload_size, 
+                        std::vector<char>& frame) {
+        if (payload_size > MAX_REQUEST_PAYLOAD) {
+            return false;
+        }
+
+        Request framed = header;
+        framed.payload_length = static_cast<uint32_t>(payload_size);
+        frame.resize(sizeof(Request) + payload_size);
+        memcpy(frame.data(), &framed, sizeof(Request));
+        if (payload_size > 0) {
+            memcpy(frame.data() + sizeof(Request), payload, payload_size);
+        }
+        return true;
+    }
+
+    void encode_response(const Response& header, const void* payload, size_t payload_size, 
+                         std::vector<char>& frame) {
+        Response framed = header;
+        framed.payload_length = static_cast<uint32_t>(payload_size);
+        frame.resize(sizeof(Response) + payload_size);
+        memcpy(frame.data(), &framed, sizeof(Response));
+        if (payload_size > 0) {
+            memcpy(frame.data() + sizeof(Response), payload, payload_size);
+        }
+    }
+
+    RequestReader::RequestReader() : offset_(0), dropped_(0) {}
+
+    void RequestReader::append(const char* data, size_t size) {
+        if (offset_ > 0 && offset_ == buffer_.size()) {
+            buffer_.clear();
+            offset_ = 0;
+        } else if (offset_ > buffer_.size() / 2) {
+            buffer_.erase(buffer_.begin(), buffer_.begin() + offset_);
+            offset_ = 0;
+        }
+        buffer_.insert(buffer_.end(), data, data + size);
+    }
+
+    bool RequestReader::next(Request& header, std::vector<char>& payload) {
+        if (buffered() < sizeof(Request)) {
+            return false;
+        }
+
+        memcpy(&header, buffer_.data() + offset_, sizeof(Request));
+        if (header.payload_length > MAX_REQUEST_PAYLOAD) {
+            dropped_ += buffered();
+            buffer_.clear();
+            offset_ = 0;
+            return false;
+        }
+
+        size_t frame_size = sizeof(Request) + header.payload_length;
+        if (buffered() < frame_size) {
+            return false;
+        }
+
+        const char* body = buffer_.data() + offset_ + sizeof(Request);
+        payload.assign(body, body + header.payload_length);
+        offset_ += frame_size;
+        return true;
+    }
+
+}
@@ -0,0 +1,128 @@
+#include "record_cache.h"
+#include <algorithm>
+
+namespace EmployeeSystem {
+
+    RecordCache::RecordCache(size_t capacity, WriteBack write_back)
+        : capacity_(std::max<size_t>(1, capacity)), write_back_(std::move(write_back)) {
+        entries_.reserve(capacity_);
+        stats_.capacity = capacity_;
+    }
+
+    bool RecordCache::write_back_locked(Entry& entry) {
+        if (!entry.dirty) {
+            return true;
+        }
+        if (!write_back_(entry.slot, entry.employee)) {
+            return false;
+        }
+        entry.dirty = false;
+        --stats_.dirty;
+        ++stats_.write_backs;
+        return true;
+    }
+
+    bool RecordCache::evict_locked() {
+        while (entries_.size() > capacity_) {
+            Entry& victim = lru_.back();
+            if (!write_back_locked(victim)) {
+                return false;
+            }
+            entries_.erase(victim.slot);
+            lru_.pop_back();
+            ++stats_.evictions;
+        }
+        return true;
+    }
+
+    void RecordCache::evict_clean_locked() {
+        for (auto it = lru_.end(); entries_.size() > capacity_ && it != lru_.begin(); ) {
+            --it;
+            if (!it->dirty) {
+                entries_.erase(it->slot);
+                it = lru_.erase(it);
+                ++stats_.evictions;
+            }
+        }
+    }
+
+    bool RecordCache::lookup(size_t slot, Employee& employee) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(slot);
+        if (it == entries_.end()) {
+            ++stats_.misses;
+            return false;
+        }
+        lru_.splice(lru_.begin(), lru_, it->second);
+        employee = it->second->employee;
+        ++stats_.hits;
+        return true;
+    }
+
+    bool RecordCache::fill(size_t slot, const Employee& employee) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.count(slot)) {
+            return true;
+        }
+        lru_.push_front(Entry{slot, employee, false});
+        entries_.emplace(slot, lru_.begin());
+        evict_clean_locked();
+        return true;
+    }
+
+    bool RecordCache::put(size_t slot, const Employee& employee, bool dirty) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(slot);
+        if (it == entries_.end()) {
+            lru_.push_front(Entry{slot, employee, false});
+            it = entries_.emplace(slot, lru_.begin()).first;
+        } else {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            it->second->employee = employee;
+        }
+
+        Entry& entry = *it->second;
+        if (dirty && !entry.dirty) {
+            ++stats_.dirty;
+        } else if (!dirty && entry.dirty) {
+            --stats_.dirty;
+        }
+        entry.dirty = dirty;
+        return evict_locked();
+    }
+
+    bool RecordCache::flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool ok = true;
+        for (auto& entry : lru_) {
+            ok = write_back_locked(entry) && ok;
+        }
+        return ok;
+    }
+
+    std::map<size_t, Employee> RecordCache::dirty_entries() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<size_t, Employee> dirty;
+        for (const auto& entry : lru_) {
+            if (entry.dirty) {
+                dirty.emplace(entry.slot, entry.employee);
+            }
+        }
+        return dirty;
+    }
+
+    void RecordCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lru_.clear();
+        entries_.clear();
+        stats_.dirty = 0;
+    }
+
+    RecordCache::Stats RecordCache::stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.size = entries_.size();
+        return stats;
+    }
+
+}
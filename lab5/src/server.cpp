@@ -17,42 +17,756 @@
 #include <algorithm>
 #include <system_error>
 #include <memory>
+#include <csignal>
+#include <cerrno>
+#include <chrono>
+#ifdef __linux__
+#include <sys/signalfd.h>
+#endif
 
 #include "employee_types.h"
 #include "file_manager.h"
 #include "lock_manager.h"
+#include "metrics.h"
 #include "fifo_manager.h"
+#include "shm_channel.h"
+#include "socket_channel.h"
+#include "event_loop.h"
+#include "protocol.h"
+#include "worker_pool.h"
 #include "logger.h"
 
 namespace EmployeeSystem {
     
+    struct ServerOptions {
+        FileOptions file;
+        size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        std::chrono::milliseconds lease{30000};
+        bool async_log = false;
+        std::string stats_file;
+        std::chrono::milliseconds stats_interval{10000};
+        bool headless = false;
+        std::string data_file = "employees.dat";
+        size_t employees = 0;
+    };
+    
     class EmployeeServer {
     private:
+        struct SocketSession {
+            std::shared_ptr<SocketChannel> channel;
+            RequestReader reader;
+            int32_t client_id = 0;
+            bool bound = false;
+        };
+        
+        static constexpr int LEASE_CHECK_MS = 250;
+        static constexpr int SHM_POLL_MS = 200;
+        static constexpr int SHM_FLUSH_MS = 2;
+        static constexpr int SEND_STALL_MS = 5000;
+        
+        ServerOptions options_;
         FileManager file_manager_;
         LockManager lock_manager_;
         std::atomic<bool> running_{false};
+        std::mutex serving_mutex_;
+        std::condition_variable serving_cv_;
+        bool serving_ = false;
         std::vector<pid_t> client_processes_;
+        std::map<int32_t, std::shared_ptr<Channel>> client_channels_;
+        std::set<const Channel*> closing_channels_;
+        std::map<int32_t, std::thread> shm_readers_;
+        std::mutex channels_mutex_;
         std::string filename_;
+        EventLoop event_loop_;
+        RequestReader inbox_;
+        std::unique_ptr<SocketListener> listener_;
+        int signal_fd_ = -1;
+        bool writers_blocked_ = false;
+        std::unique_ptr<WorkerPool> workers_;
+        ServerMetrics metrics_;
+        LockManager::Clock::time_point next_stats_dump_;
+        
+        void detach_channel_locked(std::map<int32_t, std::shared_ptr<Channel>>::iterator it) {
+            if (it->second->fd() >= 0) {
+                event_loop_.remove(it->second->fd());
+            }
+            it->second->close();
+            closing_channels_.erase(it->second.get());
+            client_channels_.erase(it);
+        }
+        
+        std::shared_ptr<Channel> client_channel(int32_t client_id, bool reconnect) {
+            std::lock_guard<std::mutex> lock(channels_mutex_);
+            auto it = client_channels_.find(client_id);
+            if (it != client_channels_.end()) {
+                if (!reconnect) {
+                    return it->second;
+                }
+                detach_channel_locked(it);
+            }
+            
+            std::shared_ptr<Channel> channel = 
+                FIFOManager::open_channel(FIFOManager::client_fifo_path(client_id), O_WRONLY);
+            if (!channel) {
+                return nullptr;
+            }
+            
+            int fd = channel->fd();
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            client_channels_[client_id] = channel;
+            event_loop_.add(fd, 0, [this, client_id, channel](uint32_t events) {
+                if (events & EventLoop::HANGUP) {
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(client_id) + " closed its FIFO");
+                    disconnect_client(client_id, channel.get());
+                } else if (events & EventLoop::WRITABLE) {
+                    flush_client(client_id, channel);
+                }
+            });
+            return channel;
+        }
+        
+        void disconnect_client(int32_t client_id, const Channel* expected = nullptr) {
+            {
+                std::lock_guard<std::mutex> lock(channels_mutex_);
+                auto it = client_channels_.find(client_id);
+                if (it == client_channels_.end() || (expected && it->second.get() != expected)) {
+                    return;
+                }
+                detach_channel_locked(it);
+            }
+            release_client_locks(client_id);
+        }
+        
+        void release_client_locks(int32_t client_id, std::function<void()> done = nullptr) {
+            auto remaining = std::make_shared<std::atomic<size_t>>(workers_->size());
+            for (size_t shard = 0; shard < workers_->size(); ++shard) {
+                workers_->submit_to(shard, [this, client_id, shard, remaining, done]() {
+                    lock_manager_.release_locks_if(client_id, [this, shard](int32_t employee_id) {
+                        return workers_->shard_for(employee_id) == shard;
+                    });
+                    if (remaining->fetch_sub(1) == 1 && done) {
+                        done();
+                    }
+                });
+            }
+        }
+        
+        void connect_shm_client(const Request& req, const std::vector<char>& payload) {
+            std::string name(payload.begin(), std::find(payload.begin(), payload.end(), '\0'));
+            std::shared_ptr<ShmChannel> channel = ShmChannel::attach(name);
+            if (!channel) {
+                EMPLOYEE_LOG_ERROR("Failed to attach shared memory: " + name);
+                return;
+            }
+            
+            std::lock_guard<std::mutex> lock(channels_mutex_);
+            auto it = client_channels_.find(req.client_id);
+            if (it != client_channels_.end()) {
+                detach_channel_locked(it);
+            }
+            std::thread previous;
+            auto reader = shm_readers_.find(req.client_id);
+            if (reader != shm_readers_.end()) {
+                previous = std::move(reader->second);
+            }
+            client_channels_[req.client_id] = channel;
+            shm_readers_[req.client_id] = std::thread([this, req, channel, previous = std::move(previous)]() mutable {
+                if (previous.joinable()) {
+                    previous.join();
+                }
+                release_client_locks(req.client_id);
+                EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " connected over shared memory");
+                route(req, std::vector<char>(), channel);
+                read_shm_client(req.client_id, channel);
+            });
+        }
+        
+        void read_shm_client(int32_t client_id, const std::shared_ptr<ShmChannel>& channel) {
+            while (running_) {
+                int timeout = SHM_POLL_MS;
+                Channel::Clock::time_point since;
+                if (channel->blocked_since(since)) {
+                    flush_client(client_id, channel);
+                    if (channel->blocked_since(since)) {
+                        timeout = SHM_FLUSH_MS;
+                    }
+                }
+                
+                Request req;
+                if (!channel->receive(&req, sizeof(Request), timeout)) {
+                    if (channel->closed() || !channel->peer_alive()) {
+                        break;
+                    }
+                    continue;
+                }
+                if (req.payload_length > MAX_REQUEST_PAYLOAD) {
+                    EMPLOYEE_LOG_ERROR("Discarded malformed request frame");
+                    break;
+                }
+                
+                std::vector<char> payload(req.payload_length);
+                if (!payload.empty() && !channel->receive(payload.data(), payload.size())) {
+                    break;
+                }
+                lock_manager_.renew_lease(req.client_id);
+                route(req, std::move(payload), channel);
+            }
+            
+            if (running_) {
+                EMPLOYEE_LOG_INFO("Client " + std::to_string(client_id) + " left shared memory session");
+            }
+            disconnect_client(client_id, channel.get());
+        }
+        
+        void accept_socket_clients() {
+            while (auto accepted = listener_->accept()) {
+                auto session = std::make_shared<SocketSession>();
+                session->channel = std::move(accepted);
+                int fd = session->channel->fd();
+                auto handler = [this, session](uint32_t events) {
+                    if (events & EventLoop::WRITABLE) {
+                        flush_client(session->client_id, session->channel);
+                    }
+                    if (events & ~EventLoop::WRITABLE) {
+                        read_socket_client(session);
+                    }
+                };
+                if (!event_loop_.add(fd, EventLoop::READABLE, handler)) {
+                    EMPLOYEE_LOG_ERROR("Failed to watch client socket");
+                }
+            }
+        }
+        
+        void read_socket_client(const std::shared_ptr<SocketSession>& session) {
+            char buffer[SocketChannel::MAX_PACKET];
+            bool open = true;
+            while (true) {
+                ssize_t n = session->channel->receive_packet(buffer, sizeof(buffer));
+                if (n > 0) {
+                    session->reader.append(buffer, static_cast<size_t>(n));
+                    continue;
+                }
+                open = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+                break;
+            }
+            
+            Request req;
+            std::vector<char> payload;
+            size_t dropped = session->reader.dropped();
+            while (session->reader.next(req, payload)) {
+                dispatch_socket(*session, req, std::move(payload));
+            }
+            if (session->reader.dropped() != dropped) {
+                EMPLOYEE_LOG_ERROR("Discarded malformed request frame");
+            }
+            
+            if (!open) {
+                event_loop_.remove(session->channel->fd());
+                if (session->bound) {
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(session->client_id) + " closed its socket");
+                    disconnect_client(session->client_id, session->channel.get());
+                }
+            }
+        }
+        
+        void dispatch_socket(SocketSession& session, const Request& req, std::vector<char> payload) {
+            if (req.operation == OperationType::CONNECT) {
+                {
+                    std::lock_guard<std::mutex> lock(channels_mutex_);
+                    auto it = client_channels_.find(req.client_id);
+                    if (it != client_channels_.end() && it->second != session.channel) {
+                        detach_channel_locked(it);
+                    }
+                    client_channels_[req.client_id] = session.channel;
+                }
+                release_client_locks(req.client_id);
+                session.client_id = req.client_id;
+                session.bound = true;
+                EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " connected over socket");
+            } else if (!session.bound || session.client_id != req.client_id) {
+                EMPLOYEE_LOG_WARN("Ignored socket request from unregistered client " + 
+                                  std::to_string(req.client_id));
+                return;
+            }
+            
+            lock_manager_.renew_lease(req.client_id);
+            route(req, std::move(payload), session.channel);
+        }
+        
+        void flush_client(int32_t client_id, const std::shared_ptr<Channel>& channel) {
+            SendResult result = channel->flush();
+            if (result == SendResult::QUEUED) {
+                return;
+            }
+            if (result == SendResult::FAILED) {
+                EMPLOYEE_LOG_WARN("Client " + std::to_string(client_id) + " disconnected");
+                disconnect_client(client_id, channel.get());
+                return;
+            }
+            
+            event_loop_.modify(channel->fd(), 0, EventLoop::WRITABLE);
+            Channel::Clock::time_point since;
+            bool closing;
+            {
+                std::lock_guard<std::mutex> lock(channels_mutex_);
+                if (channel->blocked_since(since)) {
+                    event_loop_.modify(channel->fd(), EventLoop::WRITABLE);
+                    return;
+                }
+                closing = closing_channels_.count(channel.get()) > 0;
+            }
+            if (closing) {
+                disconnect_client(client_id, channel.get());
+            }
+        }
+        
+        void disconnect_stalled_clients() {
+            std::vector<std::pair<int32_t, const Channel*>> stalled;
+            auto now = Channel::Clock::now();
+            writers_blocked_ = false;
+            {
+                std::lock_guard<std::mutex> lock(channels_mutex_);
+                for (const auto& entry : client_channels_) {
+                    Channel::Clock::time_point since;
+                    if (!entry.second->blocked_since(since)) {
+                        continue;
+                    }
+                    if (now - since >= std::chrono::milliseconds(SEND_STALL_MS)) {
+                        stalled.emplace_back(entry.first, entry.second.get());
+                    } else {
+                        writers_blocked_ = true;
+                    }
+                }
+            }
+            for (const auto& entry : stalled) {
+                EMPLOYEE_LOG_WARN("Client " + std::to_string(entry.first) + 
+                                  " stopped reading replies, disconnecting");
+                disconnect_client(entry.first, entry.second);
+            }
+        }
+        
+        void drain_server_fifo(int fd) {
+            char buffer[BUFFER_SIZE * 4];
+            while (true) {
+                ssize_t n = ::read(fd, buffer, sizeof(buffer));
+                if (n > 0) {
+                    inbox_.append(buffer, static_cast<size_t>(n));
+                } else if (n < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    break;
+                }
+            }
+            
+            Request req;
+            std::vector<char> payload;
+            size_t dropped = inbox_.dropped();
+            while (inbox_.next(req, payload)) {
+                dispatch(req, std::move(payload));
+            }
+            if (inbox_.dropped() != dropped) {
+                EMPLOYEE_LOG_ERROR("Discarded malformed request frame");
+            }
+        }
+        
+        void watch_child_exits() {
+#ifdef __linux__
+            sigset_t mask = block_child_signals();
+            signal_fd_ = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+            if (signal_fd_ < 0) {
+                return;
+            }
+            event_loop_.add(signal_fd_, EventLoop::READABLE, [this](uint32_t) {
+                signalfd_siginfo info;
+                while (::read(signal_fd_, &info, sizeof(info)) == sizeof(info)) {
+                }
+                reap_clients();
+            });
+#endif
+        }
+        
+        void reap_clients() {
+            for (auto it = client_processes_.begin(); it != client_processes_.end(); ) {
+                int status;
+                pid_t result = waitpid(*it, &status, WNOHANG);
+                if (result > 0) {
+                    EMPLOYEE_LOG_INFO("Client process " + std::to_string(*it) + " finished");
+                    release_client_locks(*it);
+                    it = client_processes_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        
+        void dispatch(const Request& req, std::vector<char> payload = std::vector<char>()) {
+            lock_manager_.renew_lease(req.client_id);
+            bool connecting = req.operation == OperationType::CONNECT;
+            if (connecting && !payload.empty()) {
+                connect_shm_client(req, payload);
+                return;
+            }
+            if (connecting) {
+                release_client_locks(req.client_id);
+            }
+            
+            auto channel = client_channel(req.client_id, connecting);
+            if (!channel) {
+                EMPLOYEE_LOG_ERROR("Failed to open client FIFO: " + 
+                                   FIFOManager::client_fifo_path(req.client_id));
+                release_client_locks(req.client_id);
+                return;
+            }
+            
+            route(req, std::move(payload), channel);
+        }
+        
+        void route(const Request& req, std::vector<char> payload, const std::shared_ptr<Channel>& channel) {
+            if (req.operation == OperationType::CONNECT) {
+                Response resp;
+                resp.employee_id = req.employee_id;
+                resp.timestamp = req.timestamp;
+                resp.status = ResponseStatus::SUCCESS;
+                EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " connected");
+                reply(req, resp, channel);
+                return;
+            }
+            if (req.operation == OperationType::STATS) {
+                Response resp;
+                resp.employee_id = req.employee_id;
+                resp.timestamp = req.timestamp;
+                resp.status = ResponseStatus::SUCCESS;
+                std::string report = metrics_.report(lock_manager_.stats(), file_manager_.cache_stats());
+                reply(req, resp, channel, std::vector<char>(report.begin(), report.end()));
+                return;
+            }
+            
+            auto received = ServerMetrics::Clock::now();
+            if (req.operation == OperationType::EXIT) {
+                EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " exiting");
+                release_client_locks(req.client_id, [this, req, channel, received]() {
+                    Response resp;
+                    resp.employee_id = req.employee_id;
+                    resp.timestamp = req.timestamp;
+                    resp.status = ResponseStatus::SUCCESS;
+                    reply(req, resp, channel);
+                    metrics_.record(req.operation, Phase::TOTAL, ServerMetrics::Clock::now() - received);
+                });
+                return;
+            }
+            
+            auto body = std::make_shared<std::vector<char>>(std::move(payload));
+            WorkerPool::Task task = [this, req, body, channel, received]() {
+                metrics_.record(req.operation, Phase::QUEUE_WAIT, ServerMetrics::Clock::now() - received);
+                if (wait_for_lock(req, channel, received)) {
+                    return;
+                }
+                Response resp;
+                std::vector<char> reply_payload;
+                if (req.operation == OperationType::BATCH_READ || req.operation == OperationType::BATCH_WRITE) {
+                    handle_batch(req, *body, resp, reply_payload);
+                } else if (req.operation == OperationType::ATOMIC) {
+                    handle_atomic(req, *body, resp);
+                } else if (req.operation == OperationType::QUERY_NAME) {
+                    handle_name_query(req, *body, resp, reply_payload);
+                } else if (req.operation == OperationType::SCAN || req.operation == OperationType::AGGREGATE) {
+                    handle_range_query(req, *body, resp, reply_payload);
+                } else {
+                    handle_request(req, resp);
+                }
+                reply(req, resp, channel, reply_payload);
+                metrics_.record(req.operation, Phase::TOTAL, ServerMetrics::Clock::now() - received);
+            };
+            if (touches_many_records(req.operation)) {
+                workers_->submit_any(std::move(task));
+            } else {
+                workers_->submit(req.employee_id, std::move(task));
+            }
+        }
+        
+        static bool touches_many_records(OperationType operation) {
+            switch (operation) {
+                case OperationType::BATCH_READ:
+                case OperationType::BATCH_WRITE:
+                case OperationType::QUERY_NAME:
+                case OperationType::SCAN:
+                case OperationType::AGGREGATE:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+        
+        bool wait_for_lock(const Request& req, const std::shared_ptr<Channel>& channel,
+                           ServerMetrics::Clock::time_point received) {
+            bool exclusive = req.operation == OperationType::WRITE;
+            if ((!exclusive && req.operation != OperationType::READ) || req.lock_timeout_ms == 0 ||
+                !file_manager_.contains(req.employee_id)) {
+                return false;
+            }
+            
+            auto requested = ServerMetrics::Clock::now();
+            lock_manager_.acquire_lock_async(req.employee_id, req.client_id, exclusive,
+                                             std::chrono::milliseconds(req.lock_timeout_ms),
+                                             [this, req, channel, received, requested](bool granted) {
+                metrics_.record(req.operation, Phase::LOCK_WAIT, ServerMetrics::Clock::now() - requested);
+                workers_->submit(req.employee_id, [this, req, channel, granted, received]() {
+                    Response resp;
+                    resp.employee_id = req.employee_id;
+                    resp.timestamp = req.timestamp;
+                    if (!granted) {
+                        resp.status = ResponseStatus::LOCKED;
+                        EMPLOYEE_LOG_DEBUG("Lock wait timed out for client " + 
+                                   std::to_string(req.client_id));
+                    } else if (req.operation == OperationType::WRITE) {
+                        perform_write(req, resp);
+                    } else {
+                        perform_read(req, resp);
+                    }
+                    reply(req, resp, channel);
+                    metrics_.record(req.operation, Phase::TOTAL, ServerMetrics::Clock::now() - received);
+                });
+            });
+            return true;
+        }
+        
+        int wait_timeout_ms() {
+            int timeout = signal_fd_ >= 0 ? -1 : 100;
+            LockManager::Clock::time_point deadline;
+            if (lock_manager_.next_waiter_deadline(deadline)) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - LockManager::Clock::now()).count() + 1;
+                int wait = static_cast<int>(std::max<long long>(0, remaining));
+                if (timeout < 0 || wait < timeout) {
+                    timeout = wait;
+                }
+            }
+            if ((writers_blocked_ || lock_manager_.lease_count() > 0) && 
+                (timeout < 0 || timeout > LEASE_CHECK_MS)) {
+                timeout = LEASE_CHECK_MS;
+            }
+            if (!options_.stats_file.empty()) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    next_stats_dump_ - LockManager::Clock::now()).count() + 1;
+                int wait = static_cast<int>(std::max<long long>(0, remaining));
+                if (timeout < 0 || wait < timeout) {
+                    timeout = wait;
+                }
+            }
+            return timeout;
+        }
+        
+        void dump_stats(bool force) {
+            auto now = LockManager::Clock::now();
+            if (options_.stats_file.empty() || (!force && now < next_stats_dump_)) {
+                return;
+            }
+            next_stats_dump_ = now + options_.stats_interval;
+            if (!metrics_.dump(options_.stats_file, lock_manager_.stats(), file_manager_.cache_stats())) {
+                EMPLOYEE_LOG_WARN("Failed to write stats file " + options_.stats_file);
+            }
+        }
+        
+        bool timed_read(const Request& req, Response& resp) {
+            auto started = ServerMetrics::Clock::now();
+            bool ok = file_manager_.read_employee(req.employee_id, resp.employee, resp.version);
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            return ok;
+        }
+        
+        bool timed_lock(const Request& req, bool exclusive) {
+            auto started = ServerMetrics::Clock::now();
+            bool ok = exclusive ? lock_manager_.acquire_write_lock(req.employee_id, req.client_id)
+                                : lock_manager_.acquire_read_lock(req.employee_id, req.client_id);
+            metrics_.record(req.operation, Phase::LOCK_WAIT, ServerMetrics::Clock::now() - started);
+            return ok;
+        }
+        
+        void perform_read(const Request& req, Response& resp) {
+            if (timed_read(req, resp)) {
+                resp.status = ResponseStatus::SUCCESS;
+                EMPLOYEE_LOG_DEBUG("Read lock acquired");
+            } else {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_ERROR("Failed to read from file");
+                lock_manager_.release_read_lock(req.employee_id, req.client_id);
+            }
+        }
+        
+        void perform_write(const Request& req, Response& resp) {
+            if (req.employee.id != 0) {
+                auto started = ServerMetrics::Clock::now();
+                bool updated = file_manager_.update_employee(req.employee_id, req.employee);
+                metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+                if (updated) {
+                    resp.status = ResponseStatus::SUCCESS;
+                    EMPLOYEE_LOG_INFO("Employee updated successfully");
+                } else {
+                    resp.status = ResponseStatus::ERROR;
+                    EMPLOYEE_LOG_ERROR("Failed to write to file");
+                    lock_manager_.release_write_lock(req.employee_id, req.client_id);
+                }
+            } else if (timed_read(req, resp)) {
+                resp.status = ResponseStatus::SUCCESS;
+                EMPLOYEE_LOG_DEBUG("Write lock acquired for modification");
+            } else {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_ERROR("Failed to read from file");
+                lock_manager_.release_write_lock(req.employee_id, req.client_id);
+            }
+        }
+        
+        static ResponseStatus status_of(UpdateResult result) {
+            switch (result) {
+                case UpdateResult::APPLIED: return ResponseStatus::SUCCESS;
+                case UpdateResult::CONFLICT: return ResponseStatus::CONFLICT;
+                case UpdateResult::NOT_FOUND: return ResponseStatus::NOT_FOUND;
+                case UpdateResult::DUPLICATE: return ResponseStatus::DUPLICATE;
+                default: return ResponseStatus::ERROR;
+            }
+        }
+        
+        static const char* storage_name(StorageMode mode) {
+            switch (mode) {
+                case StorageMode::MMAP: return "mmap";
+                case StorageMode::LOG: return "log-structured";
+                default: return "file I/O";
+            }
+        }
+        
+        void perform_compare_and_set(const Request& req, Response& resp) {
+            if (req.employee.id == 0) {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_WARN("Conditional write without employee data from client " + 
+                                  std::to_string(req.client_id));
+                return;
+            }
+            
+            auto started = ServerMetrics::Clock::now();
+            UpdateResult result = file_manager_.compare_and_update(req.employee_id, req.version, req.employee,
+                                                                   resp.employee, resp.version);
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            resp.status = status_of(result);
+            if (result == UpdateResult::FAILED) {
+                EMPLOYEE_LOG_ERROR("Failed to write to file");
+            }
+        }
+        
+        void perform_insert(const Request& req, Response& resp) {
+            if (req.employee.id != req.employee_id || req.employee.id == TOMBSTONE_ID) {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_WARN("Invalid employee id in insert from client " + std::to_string(req.client_id));
+                return;
+            }
+            
+            auto started = ServerMetrics::Clock::now();
+            UpdateResult result = file_manager_.insert_employee(req.employee, resp.version);
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            resp.status = status_of(result);
+            if (result == UpdateResult::APPLIED) {
+                resp.employee = req.employee;
+            } else if (result == UpdateResult::FAILED) {
+                EMPLOYEE_LOG_ERROR("Failed to write to file");
+            }
+        }
+        
+        void perform_delete(const Request& req, Response& resp) {
+            auto started = ServerMetrics::Clock::now();
+            UpdateResult result = file_manager_.delete_employee(req.employee_id);
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            resp.status = status_of(result);
+            if (result == UpdateResult::APPLIED) {
+                lock_manager_.release_read_lock(req.employee_id, req.client_id);
+                lock_manager_.release_write_lock(req.employee_id, req.client_id);
+            } else if (result == UpdateResult::FAILED) {
+                EMPLOYEE_LOG_ERROR("Failed to write to file");
+            }
+        }
+        
+        void reply(const Request& req, const Response& resp, const std::shared_ptr<Channel>& channel,
+                   const std::vector<char>& payload = std::vector<char>()) {
+            Response framed = resp;
+            framed.request_id = req.request_id;
+            std::vector<char> frame;
+            encode_response(framed, payload.data(), payload.size(), frame);
+            SendResult result = channel->send_queued(frame.data(), frame.size());
+            if (result == SendResult::FAILED) {
+                EMPLOYEE_LOG_WARN("Client " + std::to_string(req.client_id) + " disconnected");
+                disconnect_client(req.client_id, channel.get());
+                return;
+            }
+            if (result == SendResult::QUEUED) {
+                event_loop_.modify(channel->fd(), EventLoop::WRITABLE);
+                event_loop_.wakeup();
+            }
+            
+            if (req.operation == OperationType::EXIT) {
+                Channel::Clock::time_point since;
+                bool drained;
+                {
+                    std::lock_guard<std::mutex> lock(channels_mutex_);
+                    drained = !channel->blocked_since(since);
+                    if (!drained) {
+                        closing_channels_.insert(channel.get());
+                    }
+                }
+                if (drained) {
+                    disconnect_client(req.client_id, channel.get());
+                }
+            }
+        }
         
     public:
-        EmployeeServer(const std::string& filename) 
-            : file_manager_(filename), filename_(filename) {}
+        static sigset_t block_child_signals() {
+            sigset_t mask;
+            sigemptyset(&mask);
+            sigaddset(&mask, SIGCHLD);
+            pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+            return mask;
+        }
+        
+        EmployeeServer(const std::string& filename, const ServerOptions& options = ServerOptions()) 
+            : options_(options), file_manager_(filename, options.file), filename_(filename) {
+            lock_manager_.set_lease_duration(options.lease);
+        }
         
         bool initialize() {
             if (!FIFOManager::create_fifo(SERVER_FIFO)) {
-                Logger::log(Logger::Level::ERROR, "Failed to create server FIFO");
+                EMPLOYEE_LOG_ERROR("Failed to create server FIFO");
                 return false;
             }
             
+            listener_ = SocketListener::listen(SERVER_SOCKET);
+            if (!listener_) {
+                EMPLOYEE_LOG_WARN(std::string("Failed to listen on ") + SERVER_SOCKET + 
+                                  ", socket clients disabled");
+            }
+            
             if (!file_manager_.open()) {
-                Logger::log(Logger::Level::ERROR, "Failed to open employee file");
+                EMPLOYEE_LOG_ERROR("Failed to open employee file");
                 return false;
             }
             
-            Logger::log(Logger::Level::INFO, "Server initialized successfully");
+            EMPLOYEE_LOG_INFO(std::string("Server initialized successfully (") +
+                       storage_name(file_manager_.mode()) + " storage)");
             return true;
         }
         
+        void generate_employee_file(size_t count) {
+            std::vector<Employee> employees;
+            employees.reserve(count);
+            for (size_t i = 1; i <= count; ++i) {
+                employees.emplace_back(static_cast<int32_t>(i), "emp" + std::to_string(i), 
+                                       static_cast<double>(i % 160));
+            }
+            
+            if (file_manager_.write_all(employees)) {
+                EMPLOYEE_LOG_INFO("Generated " + std::to_string(count) + " employees");
+            } else {
+                EMPLOYEE_LOG_ERROR("Failed to create employee file");
+            }
+        }
+        
         void create_employee_file() {
             std::vector<Employee> employees;
             int num_employees;
@@ -76,9 +790,9 @@ namespace EmployeeSystem {
             }
             
             if (file_manager_.write_all(employees)) {
-                Logger::log(Logger::Level::INFO, "Employee file created successfully");
+                EMPLOYEE_LOG_INFO("Employee file created successfully");
             } else {
-                Logger::log(Logger::Level::ERROR, "Failed to create employee file");
+                EMPLOYEE_LOG_ERROR("Failed to create employee file");
             }
         }
         
@@ -127,66 +841,294 @@ namespace EmployeeSystem {
             std::cout << "\nAll clients should be running now in separate Terminal windows.\n";
         }
         
-        void handle_request(const Request& req, Response& resp) {
+        void handle_batch(const Request& req, const std::vector<char>& payload, Response& resp,
+                          std::vector<char>& reply_payload) {
             resp.employee_id = req.employee_id;
             resp.timestamp = req.timestamp;
+            auto started = ServerMetrics::Clock::now();
             
-            auto employees = file_manager_.read_all();
-            Employee* emp = file_manager_.find_employee(employees, req.employee_id);
+            std::vector<BatchResult> results;
+            bool decoded;
+            if (req.operation == OperationType::BATCH_READ) {
+                std::vector<int32_t> ids;
+                decoded = decode_items(payload, ids);
+                results.resize(ids.size());
+                for (size_t i = 0; decoded && i < ids.size(); ++i) {
+                    results[i].employee_id = ids[i];
+                    batch_read(req.client_id, results[i]);
+                }
+            } else {
+                std::vector<BatchWriteItem> items;
+                decoded = decode_items(payload, items);
+                results.resize(items.size());
+                for (size_t i = 0; decoded && i < items.size(); ++i) {
+                    results[i].employee_id = items[i].employee_id;
+                    batch_write(req.client_id, items[i], results[i]);
+                }
+            }
+            
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            if (!decoded) {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_WARN("Malformed batch from client " + std::to_string(req.client_id));
+                return;
+            }
+            
+            EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " batch of " + 
+                       std::to_string(results.size()) + " employees");
+            resp.status = ResponseStatus::SUCCESS;
+            reply_payload.resize(results.size() * sizeof(BatchResult));
+            if (!results.empty()) {
+                std::memcpy(reply_payload.data(), results.data(), reply_payload.size());
+            }
+        }
+        
+        void batch_read(int32_t client_id, BatchResult& result) {
+            if (!file_manager_.contains(result.employee_id)) {
+                result.status = ResponseStatus::NOT_FOUND;
+                return;
+            }
+            
+            bool held = lock_manager_.is_held_by(result.employee_id, client_id, false);
+            if (!held && !lock_manager_.acquire_read_lock(result.employee_id, client_id)) {
+                result.status = ResponseStatus::LOCKED;
+                return;
+            }
+            result.status = file_manager_.read_employee(result.employee_id, result.employee) 
+                                ? ResponseStatus::SUCCESS : ResponseStatus::ERROR;
+            if (!held) {
+                lock_manager_.release_read_lock(result.employee_id, client_id);
+            }
+        }
+        
+        void batch_write(int32_t client_id, const BatchWriteItem& item, BatchResult& result) {
+            if (!file_manager_.contains(item.employee_id)) {
+                result.status = ResponseStatus::NOT_FOUND;
+                return;
+            }
+            
+            bool held = lock_manager_.is_held_by(item.employee_id, client_id, true);
+            if (!held && !lock_manager_.acquire_write_lock(item.employee_id, client_id)) {
+                result.status = ResponseStatus::LOCKED;
+                return;
+            }
+            if (file_manager_.update_employee(item.employee_id, item.employee)) {
+                result.status = ResponseStatus::SUCCESS;
+                result.employee = item.employee;
+            } else {
+                result.status = ResponseStatus::ERROR;
+            }
+            if (!held) {
+                lock_manager_.release_write_lock(item.employee_id, client_id);
+            }
+        }
+        
+        static bool apply_atomic(const std::vector<AtomicUpdate>& updates, Employee& employee) {
+            for (const auto& update : updates) {
+                switch (update.kind) {
+                    case AtomicKind::ADD_HOURS:
+                        employee.hours += update.hours;
+                        break;
+                    case AtomicKind::SET_NAME:
+                        memset(employee.name, 0, sizeof(employee.name));
+                        strncpy(employee.name, update.name, sizeof(employee.name) - 1);
+                        break;
+                    case AtomicKind::SET_HOURS_IF:
+                        if (employee.hours != update.expected_hours) {
+                            return false;
+                        }
+                        employee.hours = update.hours;
+                        break;
+                    default:
+                        return false;
+                }
+            }
+            return true;
+        }
+        
+        void handle_atomic(const Request& req, const std::vector<char>& payload, Response& resp) {
+            resp.employee_id = req.employee_id;
+            resp.timestamp = req.timestamp;
             
-            if (!emp && req.operation != OperationType::EXIT) {
+            std::vector<AtomicUpdate> updates;
+            if (!decode_items(payload, updates) || updates.empty()) {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_WARN("Malformed atomic update from client " + std::to_string(req.client_id));
+                return;
+            }
+            bool held = lock_manager_.is_held_by(req.employee_id, req.client_id, true);
+            if (!held && !timed_lock(req, true)) {
+                resp.status = ResponseStatus::LOCKED;
+                EMPLOYEE_LOG_DEBUG("Atomic update blocked by a held lock");
+                return;
+            }
+            
+            EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " applying " + 
+                       std::to_string(updates.size()) + " atomic updates to employee " + 
+                       std::to_string(req.employee_id));
+            auto started = ServerMetrics::Clock::now();
+            UpdateResult result = file_manager_.modify_employee(
+                req.employee_id, [&updates](Employee& employee) { return apply_atomic(updates, employee); },
+                resp.employee, resp.version);
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            resp.status = status_of(result);
+            if (result == UpdateResult::FAILED) {
+                EMPLOYEE_LOG_ERROR("Failed to write to file");
+            }
+            if (!held) {
+                lock_manager_.release_write_lock(req.employee_id, req.client_id);
+            }
+        }
+        
+        void handle_name_query(const Request& req, const std::vector<char>& payload, Response& resp,
+                               std::vector<char>& reply_payload) {
+            resp.employee_id = req.employee_id;
+            resp.timestamp = req.timestamp;
+            
+            std::vector<NameQuery> queries;
+            if (!decode_items(payload, queries) || queries.size() != 1) {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_WARN("Malformed name query from client " + std::to_string(req.client_id));
+                return;
+            }
+            
+            const NameQuery& query = queries.front();
+            auto started = ServerMetrics::Clock::now();
+            std::vector<int32_t> ids = file_manager_.find_by_name(NameIndex::key(query.name), 
+                                                                  query.match == NameMatch::PREFIX, MAX_NAME_MATCHES);
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            
+            EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " name query matched " + 
+                       std::to_string(ids.size()) + " employees");
+            resp.status = ResponseStatus::SUCCESS;
+            reply_payload.resize(ids.size() * sizeof(int32_t));
+            if (!ids.empty()) {
+                std::memcpy(reply_payload.data(), ids.data(), reply_payload.size());
+            }
+        }
+        
+        void handle_range_query(const Request& req, const std::vector<char>& payload, Response& resp,
+                                std::vector<char>& reply_payload) {
+            resp.employee_id = req.employee_id;
+            resp.timestamp = req.timestamp;
+            
+            std::vector<RangeQuery> queries;
+            if (!decode_items(payload, queries) || queries.size() != 1) {
+                resp.status = ResponseStatus::ERROR;
+                EMPLOYEE_LOG_WARN("Malformed range query from client " + std::to_string(req.client_id));
+                return;
+            }
+            
+            const RangeQuery& query = queries.front();
+            auto started = ServerMetrics::Clock::now();
+            bool ok;
+            if (req.operation == OperationType::SCAN) {
+                size_t limit = query.limit == 0 ? MAX_SCAN_RECORDS : std::min<size_t>(query.limit, MAX_SCAN_RECORDS);
+                std::vector<Employee> employees;
+                ok = file_manager_.scan_range(query.first_id, query.last_id, limit, employees);
+                reply_payload.resize(employees.size() * sizeof(Employee));
+                if (!employees.empty()) {
+                    std::memcpy(reply_payload.data(), employees.data(), reply_payload.size());
+                }
+            } else {
+                AggregateResult result;
+                ok = file_manager_.aggregate(query.first_id, query.last_id, result);
+                reply_payload.resize(sizeof(result));
+                std::memcpy(reply_payload.data(), &result, sizeof(result));
+            }
+            metrics_.record(req.operation, Phase::IO, ServerMetrics::Clock::now() - started);
+            
+            if (!ok) {
+                resp.status = ResponseStatus::ERROR;
+                reply_payload.clear();
+                EMPLOYEE_LOG_ERROR("Failed to read from file");
+                return;
+            }
+            EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + " range query over employees " + 
+                       std::to_string(query.first_id) + ".." + std::to_string(query.last_id));
+            resp.status = ResponseStatus::SUCCESS;
+        }
+        
+        void handle_request(const Request& req, Response& resp) {
+            resp.employee_id = req.employee_id;
+            resp.timestamp = req.timestamp;
+            
+            if (req.operation != OperationType::EXIT && req.operation != OperationType::INSERT &&
+                !file_manager_.contains(req.employee_id)) {
                 resp.status = ResponseStatus::NOT_FOUND;
-                Logger::log(Logger::Level::DEBUG, 
-                           "Employee " + std::to_string(req.employee_id) + " not found");
+                EMPLOYEE_LOG_DEBUG("Employee " + std::to_string(req.employee_id) + " not found");
                 return;
             }
             
             switch (req.operation) {
                 case OperationType::READ:
-                    Logger::log(Logger::Level::INFO, 
-                               "Client " + std::to_string(req.client_id) + 
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
                                " reading employee " + std::to_string(req.employee_id));
                     
-                    if (lock_manager_.acquire_read_lock(req.employee_id, req.client_id)) {
-                        resp.employee = *emp;
-                        resp.status = ResponseStatus::SUCCESS;
-                        Logger::log(Logger::Level::DEBUG, "Read lock acquired");
+                    if (timed_lock(req, false)) {
+                        perform_read(req, resp);
                     } else {
                         resp.status = ResponseStatus::LOCKED;
-                        Logger::log(Logger::Level::DEBUG, "Read lock denied");
+                        EMPLOYEE_LOG_DEBUG("Read lock denied");
                     }
                     break;
                     
+                case OperationType::PEEK:
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
+                               " peeking at employee " + std::to_string(req.employee_id));
+                    resp.status = timed_read(req, resp) ? ResponseStatus::SUCCESS : ResponseStatus::ERROR;
+                    break;
+                    
                 case OperationType::WRITE:
-                    Logger::log(Logger::Level::INFO, 
-                               "Client " + std::to_string(req.client_id) + 
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
                                " writing employee " + std::to_string(req.employee_id));
                     
-                    if (lock_manager_.acquire_write_lock(req.employee_id, req.client_id)) {
-                        if (req.employee.id != 0) {
-                            *emp = req.employee;
-                            if (file_manager_.write_all(employees)) {
-                                resp.status = ResponseStatus::SUCCESS;
-                                Logger::log(Logger::Level::INFO, "Employee updated successfully");
-                            } else {
-                                resp.status = ResponseStatus::ERROR;
-                                Logger::log(Logger::Level::ERROR, "Failed to write to file");
-                                lock_manager_.release_write_lock(req.employee_id, req.client_id);
-                            }
-                        } else {
-                            resp.employee = *emp;
-                            resp.status = ResponseStatus::SUCCESS;
-                            Logger::log(Logger::Level::DEBUG, "Write lock acquired for modification");
-                        }
+                    if (timed_lock(req, true)) {
+                        perform_write(req, resp);
                     } else {
                         resp.status = ResponseStatus::LOCKED;
-                        Logger::log(Logger::Level::DEBUG, "Write lock denied");
+                        EMPLOYEE_LOG_DEBUG("Write lock denied");
+                    }
+                    break;
+                    
+                case OperationType::COMPARE_AND_SET:
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
+                               " conditionally writing employee " + std::to_string(req.employee_id));
+                    
+                    if (lock_manager_.is_held_by(req.employee_id, req.client_id, true)) {
+                        perform_compare_and_set(req, resp);
+                    } else if (timed_lock(req, true)) {
+                        perform_compare_and_set(req, resp);
+                        lock_manager_.release_write_lock(req.employee_id, req.client_id);
+                    } else {
+                        resp.status = ResponseStatus::LOCKED;
+                        EMPLOYEE_LOG_DEBUG("Conditional write blocked by a held lock");
+                    }
+                    break;
+                    
+                case OperationType::INSERT:
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
+                               " inserting employee " + std::to_string(req.employee_id));
+                    perform_insert(req, resp);
+                    break;
+                    
+                case OperationType::DELETE:
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
+                               " deleting employee " + std::to_string(req.employee_id));
+                    
+                    if (lock_manager_.is_held_by(req.employee_id, req.client_id, true)) {
+                        perform_delete(req, resp);
+                    } else if (timed_lock(req, true)) {
+                        perform_delete(req, resp);
+                        lock_manager_.release_write_lock(req.employee_id, req.client_id);
+                    } else {
+                        resp.status = ResponseStatus::LOCKED;
+                        EMPLOYEE_LOG_DEBUG("Delete blocked by a held lock");
                     }
                     break;
                     
                 case OperationType::UNLOCK:
-                    Logger::log(Logger::Level::INFO, 
-                               "Client " + std::to_string(req.client_id) + 
+                    EMPLOYEE_LOG_INFO("Client " + std::to_string(req.client_id) + 
                                " unlocking employee " + std::to_string(req.employee_id));
                     
                     lock_manager_.release_read_lock(req.employee_id, req.client_id);
@@ -194,80 +1136,111 @@ namespace EmployeeSystem {
                     resp.status = ResponseStatus::SUCCESS;
                     break;
                     
-                case OperationType::EXIT:
-                    Logger::log(Logger::Level::INFO, 
-                               "Client " + std::to_string(req.client_id) + " exiting");
-                    lock_manager_.release_all_locks(req.client_id);
-                    resp.status = ResponseStatus::SUCCESS;
-                    break;
-                    
                 default:
                     resp.status = ResponseStatus::ERROR;
-                    Logger::log(Logger::Level::WARN, 
-                               "Unknown operation from client " + std::to_string(req.client_id));
+                    EMPLOYEE_LOG_WARN("Unknown operation from client " + std::to_string(req.client_id));
                     break;
             }
         }
         
         void run() {
             running_ = true;
+            {
+                std::lock_guard<std::mutex> lock(serving_mutex_);
+                serving_ = true;
+            }
             
-            auto server_fifo = FIFOManager::open_fifo(SERVER_FIFO, std::ios::in | std::ios::binary);
+            auto server_fifo = FIFOManager::open_channel(SERVER_FIFO, O_RDWR);
             if (!server_fifo) {
-                Logger::log(Logger::Level::ERROR, "Failed to open server FIFO for reading");
+                EMPLOYEE_LOG_ERROR("Failed to open server FIFO for reading");
+                finish_serving();
                 return;
             }
             
-            Logger::log(Logger::Level::INFO, "Server started, waiting for requests...");
+            int server_fd = server_fifo->fd();
+            ::fcntl(server_fd, F_SETFL, ::fcntl(server_fd, F_GETFL) | O_NONBLOCK);
+            if (!event_loop_.is_valid() || 
+                !event_loop_.add(server_fd, EventLoop::READABLE, 
+                                 [this, server_fd](uint32_t) { drain_server_fifo(server_fd); })) {
+                EMPLOYEE_LOG_ERROR("Failed to set up event loop");
+                finish_serving();
+                return;
+            }
+            if (listener_ && !event_loop_.add(listener_->fd(), EventLoop::READABLE, 
+                                              [this](uint32_t) { accept_socket_clients(); })) {
+                EMPLOYEE_LOG_WARN("Failed to watch server socket");
+            }
+            watch_child_exits();
+            workers_ = std::make_unique<WorkerPool>(options_.workers);
+            
+            EMPLOYEE_LOG_INFO("Server started with " + std::to_string(workers_->size()) + 
+                       " workers, waiting for requests...");
+            
+            lock_manager_.set_waiter_listener([this]() { event_loop_.wakeup(); });
+            next_stats_dump_ = LockManager::Clock::now() + options_.stats_interval;
             
             while (running_) {
-                Request req;
-                if (server_fifo->read(reinterpret_cast<char*>(&req), sizeof(Request))) {
-                    std::string client_fifo_path;
-                    char buffer[100];
-                    snprintf(buffer, sizeof(buffer), CLIENT_FIFO_TEMPLATE, req.client_id);
-                    client_fifo_path = buffer;
-                    
-                    auto client_fifo = FIFOManager::open_fifo(client_fifo_path, 
-                                                            std::ios::out | std::ios::binary);
-                    if (client_fifo) {
-                        Response resp;
-                        handle_request(req, resp);
-                        
-                        client_fifo->write(reinterpret_cast<const char*>(&resp), sizeof(Response));
-                        client_fifo->flush();
-                        client_fifo.reset();
-                    } else {
-                        Logger::log(Logger::Level::ERROR, 
-                                   "Failed to open client FIFO: " + client_fifo_path);
-                    }
-                } else if (!server_fifo->eof()) {
-                    Logger::log(Logger::Level::ERROR, "Error reading from FIFO");
+                event_loop_.run_once(wait_timeout_ms());
+                lock_manager_.expire_waiters();
+                for (int32_t client_id : lock_manager_.expire_leases()) {
+                    EMPLOYEE_LOG_WARN("Lease expired for client " + std::to_string(client_id) + 
+                                      ", locks released");
                 }
-                
-                for (auto it = client_processes_.begin(); it != client_processes_.end(); ) {
-                    int status;
-                    pid_t result = waitpid(*it, &status, WNOHANG);
-                    if (result > 0) {
-                        Logger::log(Logger::Level::INFO, 
-                                   "Client process " + std::to_string(*it) + " finished");
-                        lock_manager_.release_all_locks(*it);
-                        it = client_processes_.erase(it);
-                    } else {
-                        ++it;
-                    }
+                if (signal_fd_ < 0) {
+                    reap_clients();
                 }
-                
-                usleep(10000);
+                disconnect_stalled_clients();
+                dump_stats(false);
             }
             
+            event_loop_.remove(server_fd);
+            if (listener_) {
+                event_loop_.remove(listener_->fd());
+            }
+            if (signal_fd_ >= 0) {
+                event_loop_.remove(signal_fd_);
+                ::close(signal_fd_);
+                signal_fd_ = -1;
+            }
+            lock_manager_.set_waiter_listener(nullptr);
+            std::map<int32_t, std::thread> readers;
+            {
+                std::lock_guard<std::mutex> lock(channels_mutex_);
+                readers.swap(shm_readers_);
+            }
+            for (auto& entry : readers) {
+                entry.second.join();
+            }
+            workers_->stop();
+            dump_stats(true);
             server_fifo.reset();
+            {
+                std::lock_guard<std::mutex> lock(channels_mutex_);
+                while (!client_channels_.empty()) {
+                    detach_channel_locked(client_channels_.begin());
+                }
+            }
+            listener_.reset();
             FIFOManager::remove_fifo(SERVER_FIFO);
-            Logger::log(Logger::Level::INFO, "Server FIFO cleaned up");
+            EMPLOYEE_LOG_INFO("Server FIFO cleaned up");
+            finish_serving();
+        }
+        
+        void finish_serving() {
+            {
+                std::lock_guard<std::mutex> lock(serving_mutex_);
+                serving_ = false;
+            }
+            serving_cv_.notify_all();
         }
         
         void stop() {
             running_ = false;
+            event_loop_.wakeup();
+            {
+                std::unique_lock<std::mutex> lock(serving_mutex_);
+                serving_cv_.wait(lock, [this] { return !serving_; });
+            }
             
             for (int i = 0; i < client_processes_.size(); ++i) {
                 std::cout << "Closing client terminal " << (i + 1) << "..." << std::endl;
@@ -279,7 +1252,7 @@ namespace EmployeeSystem {
             }
             
             file_manager_.close();
-            Logger::log(Logger::Level::INFO, "Server stopped");
+            EMPLOYEE_LOG_INFO("Server stopped");
         }
         
         ~EmployeeServer() {
@@ -288,20 +1261,102 @@ namespace EmployeeSystem {
     };
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     using namespace EmployeeSystem;
     
-    std::string filename;
-    std::cout << "Enter employee filename: ";
-    std::cin >> filename;
+    std::signal(SIGPIPE, SIG_IGN);
     
-    EmployeeServer server(filename);
+    ServerOptions options;
+    FileOptions& file_options = options.file;
+    Logger::Level log_level;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--mmap") {
+            file_options.mode = StorageMode::MMAP;
+        } else if (arg == "--log-store") {
+            file_options.mode = StorageMode::LOG;
+        } else if (arg.rfind("--segment-records=", 0) == 0) {
+            file_options.segment_records = std::stoul(arg.substr(18));
+        } else if (arg == "--sync=async") {
+            file_options.sync = SyncPolicy::ASYNC;
+        } else if (arg == "--sync=sync") {
+            file_options.sync = SyncPolicy::SYNC;
+        } else if (arg == "--sync=none") {
+            file_options.sync = SyncPolicy::NONE;
+        } else if (arg == "--wal") {
+            file_options.wal = true;
+        } else if (arg.rfind("--checkpoint=", 0) == 0) {
+            file_options.checkpoint_interval = std::stoul(arg.substr(13));
+        } else if (arg.rfind("--cache=", 0) == 0) {
+            file_options.cache_records = std::stoul(arg.substr(8));
+        } else if (arg == "--cache-policy=write-back") {
+            file_options.cache_policy = CachePolicy::WRITE_BACK;
+        } else if (arg == "--cache-policy=write-through") {
+            file_options.cache_policy = CachePolicy::WRITE_THROUGH;
+        } else if (arg.rfind("--workers=", 0) == 0) {
+            options.workers = std::stoul(arg.substr(10));
+        } else if (arg.rfind("--lease=", 0) == 0) {
+            options.lease = std::chrono::milliseconds(std::stol(arg.substr(8)));
+        } else if (arg.rfind("--stats-file=", 0) == 0) {
+            options.stats_file = arg.substr(13);
+        } else if (arg.rfind("--stats-interval=", 0) == 0) {
+            options.stats_interval = std::chrono::milliseconds(std::max(1L, std::stol(arg.substr(17))));
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg.rfind("--file=", 0) == 0) {
+            options.data_file = arg.substr(7);
+        } else if (arg.rfind("--employees=", 0) == 0) {
+            options.employees = std::stoul(arg.substr(12));
+        } else if (arg == "--async-log") {
+            options.async_log = true;
+        } else if (arg.rfind("--log-level=", 0) == 0 && Logger::parse_level(arg.substr(12), log_level)) {
+            Logger::set_level(log_level);
+        } else {
+            std::cerr << "Usage: " << argv[0] 
+                      << " [--mmap | --log-store [--segment-records=N]] [--sync=none|async|sync] [--wal] [--checkpoint=N]"
+                      << " [--cache=RECORDS] [--cache-policy=write-through|write-back]"
+                      << " [--workers=N] [--lease=MS] [--async-log] [--log-level=debug|info|warn|error]" 
+                      << " [--stats-file=PATH] [--stats-interval=MS]"
+                      << " [--headless [--file=PATH] [--employees=N]]" << std::endl;
+            return 1;
+        }
+    }
+    
+    std::string filename = options.data_file;
+    if (!options.headless) {
+        std::cout << "Enter employee filename: ";
+        std::cin >> filename;
+    }
+    
+    EmployeeServer server(filename, options);
     
     if (!server.initialize()) {
-        Logger::log(Logger::Level::ERROR, "Server initialization failed");
+        EMPLOYEE_LOG_ERROR("Server initialization failed");
         return 1;
     }
     
+    if (options.headless) {
+        EmployeeServer::block_child_signals();
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGINT);
+        sigaddset(&mask, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+        if (options.employees > 0) {
+            server.generate_employee_file(options.employees);
+        }
+        
+        Logger::set_async(options.async_log);
+        std::thread server_thread([&server]() { server.run(); });
+        int signal_number;
+        sigwait(&mask, &signal_number);
+        
+        server.stop();
+        server_thread.join();
+        Logger::set_async(false);
+        return 0;
+    }
+    
     server.create_employee_file();
     server.display_employee_file();
     
@@ -310,8 +1365,10 @@ int main() {
     std::cin >> num_clients;
     
     if (num_clients > 0) {
+        EmployeeServer::block_child_signals();
         server.start_clients(num_clients);
         
+        Logger::set_async(options.async_log);
         std::thread server_thread([&server]() { server.run(); });
         
         std::cout << "\nServer running. Clients started in separate terminals.\n";
@@ -325,6 +1382,7 @@ int main() {
         
         server.stop();
         server_thread.join();
+        Logger::set_async(false);
         
         std::cout << "\nFinal file contents:\n";
         server.display_employee_file();
@@ -0,0 +1,408 @@
+#include "shm_channel.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#else
+#include <poll.h>
+#endif
+
+namespace EmployeeSystem {
+
+    namespace {
+
+        constexpr uint32_t SEGMENT_MAGIC = 0x45534852;
+        constexpr int MAX_WAIT_SLICE_MS = 100;
+
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock-free");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring indices must be lock-free");
+
+        void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, int timeout_ms, int bell) {
+#ifdef __linux__
+            (void)bell;
+            timespec timeout;
+            timeout.tv_sec = timeout_ms / 1000;
+            timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000;
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+            pollfd pfd{bell, POLLIN, 0};
+            if (word.load() == expected) {
+                ::poll(&pfd, 1, timeout_ms);
+            }
+            char buffer[64];
+            while (::read(bell, buffer, sizeof(buffer)) > 0) {
+            }
+#endif
+        }
+
+        void futex_wake(std::atomic<uint32_t>& word, int bell) {
+#ifdef __linux__
+            (void)bell;
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+            (void)word;
+            char byte = 1;
+            while (::write(bell, &byte, 1) < 0 && errno == EINTR) {
+            }
+#endif
+        }
+
+#ifndef __linux__
+        std::string doorbell_path(const std::string& name, int index) {
+            return "/tmp" + name + "_bell" + std::to_string(index);
+        }
+#endif
+
+        void close_doorbells(int* bells, int count) {
+            for (int i = 0; i < count; ++i) {
+                if (bells[i] >= 0) {
+                    ::close(bells[i]);
+                    bells[i] = -1;
+                }
+            }
+        }
+
+        size_t ring_bytes(size_t capacity) {
+            return sizeof(RingState) + capacity;
+        }
+
+    }
+
+    struct ShmChannel::SegmentHeader {
+        alignas(64) uint32_t magic;
+        uint32_t capacity;
+        int32_t creator_pid;
+        std::atomic<int32_t> attacher_pid;
+    };
+
+    bool ShmRing::wait(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting, bool for_data,
+                       bool bounded, Clock::time_point deadline, const std::atomic<bool>* interrupt) {
+        uint32_t observed = seq.load();
+        waiting.fetch_add(1);
+        bool ready = state_->closed.load() != 0 ||
+                     (for_data ? available() > 0 : available() < capacity_) ||
+                     (interrupt && interrupt->load());
+
+        int slice = MAX_WAIT_SLICE_MS;
+        if (!ready && bounded) {
+            auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            if (left <= 0) {
+                waiting.fetch_sub(1);
+                return false;
+            }
+            slice = static_cast<int>(std::min<long long>(left, MAX_WAIT_SLICE_MS));
+        }
+        if (!ready) {
+            futex_wait(seq, observed, slice, for_data ? data_bell_ : space_bell_);
+        }
+        waiting.fetch_sub(1);
+        return true;
+    }
+
+    size_t ShmRing::available() const {
+        return static_cast<size_t>(state_->head.load(std::memory_order_acquire) -
+                                   state_->tail.load(std::memory_order_acquire));
+    }
+
+    bool ShmRing::write(const void* data, size_t size, int timeout_ms) {
+        const char* in = static_cast<const char*>(data);
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+        size_t done = 0;
+
+        while (done < size) {
+            ssize_t count = write_some(in + done, size - done);
+            if (count < 0) {
+                return false;
+            }
+            if (count == 0) {
+                if (!wait(state_->space_seq, state_->writers_waiting, false, timeout_ms >= 0, deadline, nullptr)) {
+                    return false;
+                }
+                continue;
+            }
+            done += static_cast<size_t>(count);
+        }
+        return true;
+    }
+
+    ssize_t ShmRing::write_some(const void* data, size_t size) {
+        if (state_->closed.load()) {
+            return -1;
+        }
+
+        const char* in = static_cast<const char*>(data);
+        uint64_t head = state_->head.load(std::memory_order_relaxed);
+        uint64_t tail = state_->tail.load(std::memory_order_acquire);
+        size_t space = capacity_ - static_cast<size_t>(head - tail);
+        size_t count = std::min(space, size);
+        if (count == 0) {
+            return 0;
+        }
+
+        size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+        size_t first = std::min(count, capacity_ - offset);
+        memcpy(data_ + offset, in, first);
+        memcpy(data_, in + first, count - first);
+
+        state_->head.store(head + count, std::memory_order_release);
+        state_->data_seq.fetch_add(1);
+        if (state_->readers_waiting.load()) {
+            futex_wake(state_->data_seq, data_bell_);
+        }
+        return static_cast<ssize_t>(count);
+    }
+
+    bool ShmRing::read(void* data, size_t size, int timeout_ms, const std::atomic<bool>* interrupt) {
+        char* out = static_cast<char*>(data);
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+        size_t done = 0;
+
+        while (done < size) {
+            uint64_t tail = state_->tail.load(std::memory_order_relaxed);
+            uint64_t head = state_->head.load(std::memory_order_acquire);
+            size_t ready = static_cast<size_t>(head - tail);
+            if (ready == 0) {
+                if (state_->closed.load()) {
+                    return false;
+                }
+                bool bounded = timeout_ms >= 0 && done == 0;
+                if (bounded && interrupt && interrupt->load()) {
+                    return false;
+                }
+                if (!wait(state_->data_seq, state_->readers_waiting, true, bounded, deadline,
+                          bounded ? interrupt : nullptr)) {
+                    return false;
+                }
+                continue;
+            }
+
+            size_t count = std::min(ready, size - done);
+            size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+            size_t first = std::min(count, capacity_ - offset);
+            memcpy(out + done, data_ + offset, first);
+            memcpy(out + done + first, data_, count - first);
+
+            state_->tail.store(tail + count, std::memory_order_release);
+            state_->space_seq.fetch_add(1);
+            if (state_->writers_waiting.load()) {
+                futex_wake(state_->space_seq, space_bell_);
+            }
+            done += count;
+        }
+        return true;
+    }
+
+    void ShmRing::wake_reader() {
+        state_->data_seq.fetch_add(1);
+        if (state_->readers_waiting.load()) {
+            futex_wake(state_->data_seq, data_bell_);
+        }
+    }
+
+    void ShmRing::close() {
+        state_->closed.store(1);
+        state_->data_seq.fetch_add(1);
+        state_->space_seq.fetch_add(1);
+        futex_wake(state_->data_seq, data_bell_);
+        futex_wake(state_->space_seq, space_bell_);
+    }
+
+    bool ShmRing::closed() const {
+        return state_->closed.load() != 0;
+    }
+
+    ShmChannel::ShmChannel(const std::string& name, void* base, size_t length, bool owner, const int* bells)
+        : name_(name), base_(base), length_(length), owner_(owner),
+          header_(static_cast<SegmentHeader*>(base)),
+          outbound_([this](const char* data, size_t size) { return write_some(data, size); }),
+          flush_pending_(false) {
+        std::copy(bells, bells + DOORBELLS, bells_);
+        size_t capacity = header_->capacity;
+        char* rings = static_cast<char*>(base) + sizeof(SegmentHeader);
+        RingState* requests = reinterpret_cast<RingState*>(rings);
+        RingState* responses = reinterpret_cast<RingState*>(rings + ring_bytes(capacity));
+
+        ShmRing request_ring(requests, rings + sizeof(RingState), capacity, bells_[0], bells_[1]);
+        ShmRing response_ring(responses, rings + ring_bytes(capacity) + sizeof(RingState), capacity,
+                              bells_[2], bells_[3]);
+        tx_ = owner ? request_ring : response_ring;
+        rx_ = owner ? response_ring : request_ring;
+    }
+
+    std::unique_ptr<ShmChannel> ShmChannel::create(const std::string& name, size_t capacity) {
+        size_t rounded = 4096;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        size_t length = sizeof(SegmentHeader) + 2 * ring_bytes(rounded);
+
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            return nullptr;
+        }
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return nullptr;
+        }
+        void* base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        int bells[DOORBELLS];
+        if (base != MAP_FAILED && !open_doorbells(name, true, bells)) {
+            ::munmap(base, length);
+            base = MAP_FAILED;
+        }
+        if (base == MAP_FAILED) {
+            ::shm_unlink(name.c_str());
+            return nullptr;
+        }
+
+        SegmentHeader* header = new (base) SegmentHeader();
+        header->capacity = static_cast<uint32_t>(rounded);
+        header->creator_pid = static_cast<int32_t>(::getpid());
+        header->attacher_pid.store(0);
+        char* rings = static_cast<char*>(base) + sizeof(SegmentHeader);
+        new (rings) RingState();
+        new (rings + ring_bytes(rounded)) RingState();
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = SEGMENT_MAGIC;
+
+        return std::unique_ptr<ShmChannel>(new ShmChannel(name, base, length, true, bells));
+    }
+
+    std::unique_ptr<ShmChannel> ShmChannel::attach(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SegmentHeader)) {
+            ::close(fd);
+            return nullptr;
+        }
+        size_t length = static_cast<size_t>(info.st_size);
+        void* base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            return nullptr;
+        }
+
+        SegmentHeader* header = static_cast<SegmentHeader*>(base);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->magic != SEGMENT_MAGIC ||
+            length < sizeof(SegmentHeader) + 2 * ring_bytes(header->capacity)) {
+            ::munmap(base, length);
+            return nullptr;
+        }
+        int bells[DOORBELLS];
+        if (!open_doorbells(name, false, bells)) {
+            ::munmap(base, length);
+            return nullptr;
+        }
+        header->attacher_pid.store(static_cast<int32_t>(::getpid()));
+
+        return std::unique_ptr<ShmChannel>(new ShmChannel(name, base, length, false, bells));
+    }
+
+    bool ShmChannel::open_doorbells(const std::string& name, bool create, int* bells) {
+        std::fill(bells, bells + DOORBELLS, -1);
+#ifndef __linux__
+        for (int i = 0; i < DOORBELLS; ++i) {
+            std::string path = doorbell_path(name, i);
+            if (create) {
+                ::unlink(path.c_str());
+                ::mkfifo(path.c_str(), 0600);
+            }
+            bells[i] = ::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+            if (bells[i] < 0) {
+                close_doorbells(bells, i);
+                if (create) {
+                    remove_doorbells(name);
+                }
+                return false;
+            }
+        }
+#else
+        (void)name;
+        (void)create;
+#endif
+        return true;
+    }
+
+    void ShmChannel::remove_doorbells(const std::string& name) {
+#ifndef __linux__
+        for (int i = 0; i < DOORBELLS; ++i) {
+            ::unlink(doorbell_path(name, i).c_str());
+        }
+#else
+        (void)name;
+#endif
+    }
+
+    bool ShmChannel::send(const void* data, size_t size) {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (!tx_.write(data, size, SEND_TIMEOUT_MS)) {
+            tx_.close();
+            return false;
+        }
+        return true;
+    }
+
+    SendResult ShmChannel::send_queued(const void* data, size_t size) {
+        SendResult result = outbound_.push(data, size);
+        if (result == SendResult::QUEUED) {
+            flush_pending_.store(true);
+            rx_.wake_reader();
+        }
+        return result;
+    }
+
+    SendResult ShmChannel::flush() {
+        flush_pending_.store(false);
+        return outbound_.flush();
+    }
+
+    ssize_t ShmChannel::write_some(const char* data, size_t size) {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        return tx_.write_some(data, size);
+    }
+
+    bool ShmChannel::receive(void* data, size_t size, int timeout_ms) {
+        return rx_.read(data, size, timeout_ms, &flush_pending_);
+    }
+
+    void ShmChannel::close() {
+        tx_.close();
+        rx_.close();
+    }
+
+    bool ShmChannel::peer_alive() const {
+        pid_t peer = owner_ ? header_->attacher_pid.load() : header_->creator_pid;
+        if (peer <= 0) {
+            return true;
+        }
+        return ::kill(peer, 0) == 0 || errno == EPERM;
+    }
+
+    ShmChannel::~ShmChannel() {
+        close();
+        ::munmap(base_, length_);
+        close_doorbells(bells_, DOORBELLS);
+        if (owner_) {
+            ::shm_unlink(name_.c_str());
+            remove_doorbells(name_);
+        }
+    }
+
+}
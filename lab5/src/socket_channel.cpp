@@ -0,0 +1,212 @@
+#include "socket_channel.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace EmployeeSystem {
+
+    namespace {
+
+#ifdef __APPLE__
+        constexpr int SOCKET_TYPE = SOCK_STREAM;
+        constexpr int SEND_FLAGS = 0;
+#else
+        constexpr int SOCKET_TYPE = SOCK_SEQPACKET;
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#endif
+
+        bool make_address(const std::string& path, sockaddr_un& address) {
+            if (path.size() >= sizeof(address.sun_path)) {
+                return false;
+            }
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            return true;
+        }
+
+        int open_socket() {
+            int fd = ::socket(AF_UNIX, SOCKET_TYPE, 0);
+            if (fd < 0) {
+                return -1;
+            }
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef __APPLE__
+            int on = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+            return fd;
+        }
+
+    }
+
+    SocketChannel::SocketChannel(int fd) 
+        : fd_(fd), pending_offset_(0),
+          outbound_([this](const char* data, size_t size) { return write_some(data, size); }) {}
+
+    std::unique_ptr<SocketChannel> SocketChannel::connect(const std::string& path) {
+        sockaddr_un address;
+        if (!make_address(path, address)) {
+            return nullptr;
+        }
+        int fd = open_socket();
+        if (fd < 0) {
+            return nullptr;
+        }
+        int result;
+        do {
+            result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        } while (result < 0 && errno == EINTR);
+        if (result < 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        return std::make_unique<SocketChannel>(fd);
+    }
+
+    bool SocketChannel::send(const void* data, size_t size) {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        const char* ptr = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = ::send(fd_, ptr, std::min(size, MAX_PACKET), SEND_FLAGS);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    ssize_t SocketChannel::write_some(const char* data, size_t size) {
+        while (true) {
+            ssize_t n = ::send(fd_, data, std::min(size, MAX_PACKET), SEND_FLAGS | MSG_DONTWAIT);
+            if (n >= 0) {
+                return n;
+            }
+            if (errno != EINTR) {
+                return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+            }
+        }
+    }
+
+    bool SocketChannel::fill(int timeout_ms) {
+        pollfd pfd{fd_, POLLIN, 0};
+        int ready;
+        do {
+            ready = ::poll(&pfd, 1, timeout_ms);
+        } while (ready < 0 && errno == EINTR);
+        if (ready <= 0) {
+            return false;
+        }
+
+        pending_.resize(MAX_PACKET);
+        pending_offset_ = 0;
+        ssize_t n;
+        do {
+            n = ::recv(fd_, pending_.data(), pending_.size(), 0);
+        } while (n < 0 && errno == EINTR);
+        pending_.resize(n > 0 ? static_cast<size_t>(n) : 0);
+        return n > 0;
+    }
+
+    bool SocketChannel::receive(void* data, size_t size, int timeout_ms) {
+        char* ptr = static_cast<char*>(data);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        while (size > 0) {
+            if (pending_offset_ < pending_.size()) {
+                size_t count = std::min(size, pending_.size() - pending_offset_);
+                memcpy(ptr, pending_.data() + pending_offset_, count);
+                pending_offset_ += count;
+                ptr += count;
+                size -= count;
+                continue;
+            }
+
+            int wait_ms = -1;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                wait_ms = left > 0 ? static_cast<int>(left) : 0;
+            }
+            if (!fill(wait_ms)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ssize_t SocketChannel::receive_packet(char* data, size_t size) {
+        ssize_t n;
+        do {
+            n = ::recv(fd_, data, size, MSG_DONTWAIT);
+        } while (n < 0 && errno == EINTR);
+        return n;
+    }
+
+    void SocketChannel::close() {
+        ::shutdown(fd_, SHUT_RDWR);
+    }
+
+    SocketChannel::~SocketChannel() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    SocketListener::SocketListener(int fd, const std::string& path) : fd_(fd), path_(path) {}
+
+    std::unique_ptr<SocketListener> SocketListener::listen(const std::string& path, int backlog) {
+        sockaddr_un address;
+        if (!make_address(path, address)) {
+            return nullptr;
+        }
+        int fd = open_socket();
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        ::unlink(path.c_str());
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd, backlog) != 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return std::unique_ptr<SocketListener>(new SocketListener(fd, path));
+    }
+
+    std::unique_ptr<SocketChannel> SocketListener::accept() {
+        int fd;
+        do {
+            fd = ::accept(fd_, nullptr, nullptr);
+        } while (fd < 0 && errno == EINTR);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef __APPLE__
+        int on = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        return std::make_unique<SocketChannel>(fd);
+    }
+
+    SocketListener::~SocketListener() {
+        ::close(fd_);
+        ::unlink(path_.c_str());
+    }
+
+}
@@ -0,0 +1,87 @@
+#include "timing_wheel.h"
+
+namespace EmployeeSystem {
+
+    TimingWheel::TimingWheel(std::chrono::milliseconds tick, Clock::time_point origin)
+        : tick_(tick.count() > 0 ? tick : std::chrono::milliseconds(1)), origin_(origin),
+          current_tick_(0), size_(0) {}
+
+    uint64_t TimingWheel::tick_for(Clock::time_point time) const {
+        if (time <= origin_) {
+            return 0;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(time - origin_);
+        return static_cast<uint64_t>(elapsed.count() / tick_.count());
+    }
+
+    void TimingWheel::insert(const Timer& timer) {
+        uint64_t expiry = timer.expiry_tick > current_tick_ ? timer.expiry_tick : current_tick_ + 1;
+        uint64_t delta = expiry - current_tick_;
+
+        size_t level = 0;
+        while (level + 1 < LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+
+        uint64_t span = uint64_t(1) << (SLOT_BITS * (level + 1));
+        if (delta >= span) {
+            expiry = current_tick_ + span - 1;
+        }
+        size_t slot = (expiry >> (SLOT_BITS * level)) & (SLOTS - 1);
+        slots_[level][slot].push_back(timer);
+    }
+
+    void TimingWheel::cascade(size_t level, std::vector<int32_t>& expired) {
+        size_t slot = (current_tick_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+        std::vector<Timer> timers;
+        timers.swap(slots_[level][slot]);
+        for (const auto& timer : timers) {
+            if (timer.expiry_tick <= current_tick_) {
+                expired.push_back(timer.key);
+                --size_;
+            } else {
+                insert(timer);
+            }
+        }
+    }
+
+    void TimingWheel::schedule(int32_t key, Clock::time_point deadline) {
+        insert(Timer{key, tick_for(deadline) + 1});
+        ++size_;
+    }
+
+    void TimingWheel::advance(Clock::time_point now, std::vector<int32_t>& expired) {
+        uint64_t target = tick_for(now);
+        if (size_ == 0) {
+            current_tick_ = target > current_tick_ ? target : current_tick_;
+            return;
+        }
+
+        while (current_tick_ < target && size_ > 0) {
+            ++current_tick_;
+            for (size_t level = 1; level < LEVELS; ++level) {
+                if ((current_tick_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) {
+                    break;
+                }
+                cascade(level, expired);
+            }
+
+            auto& slot = slots_[0][current_tick_ & (SLOTS - 1)];
+            std::vector<Timer> due;
+            due.swap(slot);
+            for (const auto& timer : due) {
+                if (timer.expiry_tick <= current_tick_) {
+                    expired.push_back(timer.key);
+                    --size_;
+                } else {
+                    insert(timer);
+                }
+            }
+        }
+
+        if (current_tick_ < target) {
+            current_tick_ = target;
+        }
+    }
+
+}
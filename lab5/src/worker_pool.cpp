@@ -0,0 +1,77 @@
+#include "worker_pool.h"
+
+namespace EmployeeSystem {
+
+    WorkerPool::WorkerPool(size_t num_workers) {
+        if (num_workers == 0) {
+            num_workers = 1;
+        }
+        workers_.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        for (auto& worker : workers_) {
+            Worker* w = worker.get();
+            w->thread = std::thread([w]() { worker_loop(*w); });
+        }
+    }
+
+    size_t WorkerPool::shard_for(int32_t key) const {
+        uint32_t hash = static_cast<uint32_t>(key) * 2654435761u;
+        return hash % workers_.size();
+    }
+
+    void WorkerPool::submit(int32_t key, Task task) {
+        submit_to(shard_for(key), std::move(task));
+    }
+
+    void WorkerPool::submit_any(Task task) {
+        submit_to(next_shard_.fetch_add(1, std::memory_order_relaxed) % workers_.size(), std::move(task));
+    }
+
+    void WorkerPool::submit_to(size_t shard, Task task) {
+        Worker& worker = *workers_[shard % workers_.size()];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (worker.stopping) {
+                return;
+            }
+            worker.tasks.push_back(std::move(task));
+        }
+        worker.cv.notify_one();
+    }
+
+    void WorkerPool::worker_loop(Worker& worker) {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        while (true) {
+            worker.cv.wait(lock, [&worker] { return worker.stopping || !worker.tasks.empty(); });
+            if (worker.tasks.empty()) {
+                return;
+            }
+
+            Task task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    void WorkerPool::stop() {
+        for (auto& worker : workers_) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+        }
+        for (auto& worker : workers_) {
+            worker->cv.notify_all();
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        stop();
+    }
+
+}
@@ -0,0 +1,87 @@
+#include "workload.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace EmployeeSystem {
+
+    KeyChooser::KeyChooser(size_t keys, KeyDistribution distribution, double theta, uint64_t seed)
+        : rng_(seed), keys_(std::max<size_t>(1, keys)), distribution_(distribution),
+          theta_(std::min(std::max(theta, 0.01), 0.999)), zetan_(0), alpha_(0), eta_(0), half_pow_theta_(0) {
+        if (distribution_ == KeyDistribution::ZIPFIAN) {
+            zetan_ = zeta(keys_, theta_);
+            alpha_ = 1.0 / (1.0 - theta_);
+            eta_ = (1.0 - std::pow(2.0 / keys_, 1.0 - theta_)) / (1.0 - zeta(2, theta_) / zetan_);
+            half_pow_theta_ = 1.0 + std::pow(0.5, theta_);
+        }
+    }
+
+    double KeyChooser::zeta(size_t n, double theta) {
+        double sum = 0;
+        for (size_t i = 1; i <= n; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return sum;
+    }
+
+    double KeyChooser::uniform01() {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    }
+
+    int32_t KeyChooser::next() {
+        if (distribution_ == KeyDistribution::UNIFORM) {
+            return static_cast<int32_t>(std::uniform_int_distribution<size_t>(1, keys_)(rng_));
+        }
+
+        double u = uniform01();
+        double uz = u * zetan_;
+        size_t rank;
+        if (uz < 1.0) {
+            rank = 0;
+        } else if (uz < half_pow_theta_) {
+            rank = 1;
+        } else {
+            rank = static_cast<size_t>(keys_ * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+        }
+        return static_cast<int32_t>(std::min(rank, keys_ - 1) + 1);
+    }
+
+    bool OperationMix::parse(const std::string& spec) {
+        std::istringstream in(spec);
+        unsigned values[3];
+        char separator;
+        if (!(in >> values[0] >> separator >> values[1] >> separator >> values[2]) ||
+            values[0] + values[1] + values[2] == 0) {
+            return false;
+        }
+        read = values[0];
+        write = values[1];
+        lock = values[2];
+        return true;
+    }
+
+    WorkloadOp OperationMix::pick(std::mt19937_64& rng) const {
+        unsigned roll = std::uniform_int_distribution<unsigned>(0, read + write + lock - 1)(rng);
+        if (roll < read) {
+            return WorkloadOp::READ;
+        }
+        return roll < read + write ? WorkloadOp::WRITE : WorkloadOp::LOCK;
+    }
+
+    const char* OperationMix::name(WorkloadOp op) {
+        static const char* names[] = {"read", "write", "lock"};
+        return names[static_cast<int>(op)];
+    }
+
+    bool parse_distribution(const std::string& name, KeyDistribution& distribution) {
+        if (name == "uniform") {
+            distribution = KeyDistribution::UNIFORM;
+        } else if (name == "zipf" || name == "zipfian") {
+            distribution = KeyDistribution::ZIPFIAN;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,178 @@
+#include "write_ahead_log.h"
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EmployeeSystem {
+
+    namespace {
+
+        bool write_fully(int fd, const void* data, size_t size) {
+            const char* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+                ssize_t n = ::write(fd, ptr, size);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                ptr += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool sync_fd(int fd) {
+#ifdef __linux__
+            return ::fdatasync(fd) == 0;
+#else
+            return ::fsync(fd) == 0;
+#endif
+        }
+
+    }
+
+    WriteAheadLog::WriteAheadLog(const std::string& path)
+        : path_(path), fd_(-1), appended_seq_(0), durable_seq_(0),
+          logged_records_(0), sync_count_(0), flushing_(false), failed_(false) {}
+
+    bool WriteAheadLog::open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        failed_ = fd_ < 0;
+        return fd_ >= 0;
+    }
+
+    uint32_t WriteAheadLog::checksum(const WalRecord& record) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < offsetof(WalRecord, checksum); ++i) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    uint64_t WriteAheadLog::append(uint64_t slot, const Employee& employee) {
+        WalRecord record;
+        record.slot = slot;
+        record.employee = employee;
+        record.checksum = checksum(record);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(record);
+        ++logged_records_;
+        return ++appended_seq_;
+    }
+
+    bool WriteAheadLog::sync(uint64_t seq) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (durable_seq_ < seq) {
+            if (failed_) {
+                return false;
+            }
+            if (flushing_) {
+                cv_.wait(lock);
+                continue;
+            }
+
+            flushing_ = true;
+            std::vector<WalRecord> batch;
+            batch.swap(pending_);
+            uint64_t batch_seq = appended_seq_;
+            lock.unlock();
+
+            bool ok = batch.empty() ||
+                      (write_fully(fd_, batch.data(), batch.size() * sizeof(WalRecord)) && sync_fd(fd_));
+
+            lock.lock();
+            flushing_ = false;
+            if (ok) {
+                durable_seq_ = batch_seq;
+                ++sync_count_;
+            } else {
+                failed_ = true;
+            }
+            cv_.notify_all();
+        }
+        return true;
+    }
+
+    bool WriteAheadLog::flush() {
+        uint64_t seq;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            seq = appended_seq_;
+        }
+        return sync(seq);
+    }
+
+    size_t WriteAheadLog::replay(const std::function<bool(uint64_t, const Employee&)>& apply) {
+        int fd = ::open(path_.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return 0;
+        }
+
+        size_t applied = 0;
+        WalRecord record;
+        while (true) {
+            ssize_t n = ::read(fd, &record, sizeof(WalRecord));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n != static_cast<ssize_t>(sizeof(WalRecord)) || record.checksum != checksum(record)) {
+                break;
+            }
+            if (!apply(record.slot, record.employee)) {
+                break;
+            }
+            ++applied;
+        }
+
+        ::close(fd);
+        return applied;
+    }
+
+    bool WriteAheadLog::reset() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !flushing_; });
+        if (!pending_.empty() || fd_ < 0) {
+            return false;
+        }
+        if (::ftruncate(fd_, 0) != 0 || !sync_fd(fd_)) {
+            return false;
+        }
+        logged_records_ = 0;
+        return true;
+    }
+
+    size_t WriteAheadLog::logged_records() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return logged_records_;
+    }
+
+    size_t WriteAheadLog::sync_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sync_count_;
+    }
+
+    void WriteAheadLog::close() {
+        flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    WriteAheadLog::~WriteAheadLog() {
+        close();
+    }
+
+}
\ No newline at end of file
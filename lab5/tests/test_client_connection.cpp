@@ -0,0 +1,213 @@
+#include "client_connection.h"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+namespace EmployeeSystem {
+
+class ClientConnectionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::signal(SIGPIPE, SIG_IGN);
+        server_path_ = "/tmp/test_server_fifo_" + std::to_string(getpid());
+        ASSERT_TRUE(FIFOManager::create_fifo(server_path_));
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(server_path_);
+    }
+    
+    void ServeRequests(int count, std::atomic<int>& reply_opens) {
+        auto requests = FIFOManager::open_channel(server_path_, O_RDWR);
+        ASSERT_NE(requests, nullptr);
+        
+        std::unique_ptr<FIFOChannel> reply;
+        for (int i = 0; i < count; ++i) {
+            Request req;
+            ASSERT_TRUE(requests->receive(&req, sizeof(Request), 2000));
+            
+            if (!reply) {
+                reply = FIFOManager::open_channel(FIFOManager::client_fifo_path(req.client_id), O_WRONLY);
+                ASSERT_NE(reply, nullptr);
+                reply_opens++;
+            }
+            
+            Response resp;
+            resp.request_id = req.request_id;
+            resp.employee_id = req.employee_id;
+            resp.status = ResponseStatus::SUCCESS;
+            resp.employee = Employee(req.employee_id, "Echo", req.employee_id * 2.0);
+            ASSERT_TRUE(reply->send(&resp, sizeof(Response)));
+        }
+    }
+    
+    std::string server_path_;
+};
+
+TEST_F(ClientConnectionTest, ConnectFailsWithoutServer) {
+    ClientConnection connection(91, server_path_);
+    EXPECT_FALSE(connection.connect(100));
+    EXPECT_FALSE(connection.is_connected());
+    EXPECT_FALSE(std::filesystem::exists(connection.reply_path()));
+}
+
+TEST_F(ClientConnectionTest, ChannelsStayOpenAcrossRequests) {
+    constexpr int NUM_REQUESTS = 20;
+    std::atomic<int> reply_opens{0};
+    std::thread server([&]() { ServeRequests(NUM_REQUESTS + 1, reply_opens); });
+    
+    ClientConnection connection(92, server_path_);
+    ASSERT_TRUE(connection.connect(2000));
+    EXPECT_TRUE(std::filesystem::exists(connection.reply_path()));
+    
+    for (int i = 1; i <= NUM_REQUESTS; ++i) {
+        Request req;
+        req.client_id = 92;
+        req.employee_id = i;
+        req.operation = OperationType::READ;
+        
+        Response resp;
+        ASSERT_TRUE(connection.send_request(req, resp, 2000));
+        EXPECT_EQ(resp.status, ResponseStatus::SUCCESS);
+        EXPECT_EQ(resp.employee_id, i);
+        EXPECT_DOUBLE_EQ(resp.employee.hours, i * 2.0);
+    }
+    
+    server.join();
+    EXPECT_EQ(reply_opens, 1);
+    
+    connection.disconnect();
+    EXPECT_FALSE(std::filesystem::exists(connection.reply_path()));
+}
+
+TEST_F(ClientConnectionTest, PipelinedRepliesMatchOutOfOrder) {
+    constexpr int NUM_REQUESTS = 8;
+    std::thread server([&]() {
+        auto requests = FIFOManager::open_channel(server_path_, O_RDWR);
+        ASSERT_NE(requests, nullptr);
+        
+        Request connect;
+        ASSERT_TRUE(requests->receive(&connect, sizeof(Request), 2000));
+        auto reply = FIFOManager::open_channel(FIFOManager::client_fifo_path(connect.client_id), O_WRONLY);
+        ASSERT_NE(reply, nullptr);
+        Response accepted;
+        accepted.request_id = connect.request_id;
+        accepted.status = ResponseStatus::SUCCESS;
+        ASSERT_TRUE(reply->send(&accepted, sizeof(Response)));
+        
+        std::vector<Request> batch(NUM_REQUESTS);
+        for (auto& req : batch) {
+            ASSERT_TRUE(requests->receive(&req, sizeof(Request), 2000));
+        }
+        for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+            Response resp;
+            resp.request_id = it->request_id;
+            resp.employee_id = it->employee_id;
+            resp.status = ResponseStatus::SUCCESS;
+            ASSERT_TRUE(reply->send(&resp, sizeof(Response)));
+        }
+    });
+    
+    ClientConnection connection(94, server_path_);
+    ASSERT_TRUE(connection.connect(2000));
+    
+    std::vector<uint32_t> ids;
+    for (int i = 1; i <= NUM_REQUESTS; ++i) {
+        Request req;
+        req.client_id = 94;
+        req.employee_id = i;
+        uint32_t id = connection.submit(req);
+        ASSERT_NE(id, 0u);
+        ids.push_back(id);
+    }
+    EXPECT_EQ(connection.in_flight(), static_cast<size_t>(NUM_REQUESTS));
+    
+    for (int i = 0; i < NUM_REQUESTS; ++i) {
+        Response resp;
+        std::vector<char> payload;
+        ASSERT_TRUE(connection.wait(ids[i], resp, payload, 2000));
+        EXPECT_EQ(resp.request_id, ids[i]);
+        EXPECT_EQ(resp.employee_id, i + 1);
+    }
+    EXPECT_EQ(connection.in_flight(), 0u);
+    server.join();
+}
+
+TEST_F(ClientConnectionTest, PipelineDepthBoundsInFlightRequests) {
+    std::atomic<int> reply_opens{0};
+    std::thread server([&]() { ServeRequests(6, reply_opens); });
+    
+    ClientConnection connection(95, server_path_, 2);
+    ASSERT_TRUE(connection.connect(2000));
+    
+    std::vector<uint32_t> ids;
+    for (int i = 1; i <= 5; ++i) {
+        Request req;
+        req.client_id = 95;
+        req.employee_id = i;
+        ids.push_back(connection.submit(req, std::vector<char>(), 2000));
+        ASSERT_NE(ids.back(), 0u);
+        EXPECT_LE(connection.in_flight(), 2u);
+    }
+    
+    for (int i = 0; i < 5; ++i) {
+        Response resp;
+        std::vector<char> payload;
+        ASSERT_TRUE(connection.wait(ids[i], resp, payload, 2000));
+        EXPECT_EQ(resp.employee_id, i + 1);
+    }
+    server.join();
+}
+
+TEST_F(ClientConnectionTest, ReceiveDetectsServerHangup) {
+    std::atomic<int> reply_opens{0};
+    std::thread server([&]() { ServeRequests(1, reply_opens); });
+    
+    ClientConnection connection(93, server_path_);
+    ASSERT_TRUE(connection.connect(2000));
+    server.join();
+    
+    Request req;
+    req.client_id = 93;
+    Response resp;
+    EXPECT_FALSE(connection.send_request(req, resp, 2000));
+}
+
+TEST_F(ClientConnectionTest, TimeoutMidFrameClosesConnection) {
+    std::thread server([&]() {
+        auto requests = FIFOManager::open_channel(server_path_, O_RDWR);
+        ASSERT_NE(requests, nullptr);
+        std::unique_ptr<FIFOChannel> reply;
+        for (int i = 0; i < 2; ++i) {
+            Request req;
+            ASSERT_TRUE(requests->receive(&req, sizeof(Request), 2000));
+            if (!reply) {
+                reply = FIFOManager::open_channel(FIFOManager::client_fifo_path(req.client_id), O_WRONLY);
+                ASSERT_NE(reply, nullptr);
+            }
+            
+            Response resp;
+            resp.request_id = req.request_id;
+            resp.status = ResponseStatus::SUCCESS;
+            size_t sent = i == 0 ? sizeof(Response) : sizeof(Response) / 2;
+            ASSERT_TRUE(reply->send(&resp, sent));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    });
+    
+    ClientConnection connection(94, server_path_);
+    ASSERT_TRUE(connection.connect(2000));
+    
+    Request req;
+    req.client_id = 94;
+    Response resp;
+    EXPECT_FALSE(connection.send_request(req, resp, 100));
+    EXPECT_FALSE(connection.is_connected());
+    server.join();
+}
+
+}
@@ -55,9 +55,17 @@ TEST(EmployeeTypesTest, ResponseDefaultConstructor) {
 
 TEST(EmployeeTypesTest, OperationTypeValues) {
     EXPECT_EQ(static_cast<char>(OperationType::READ), 'R');
+    EXPECT_EQ(static_cast<char>(OperationType::PEEK), 'P');
     EXPECT_EQ(static_cast<char>(OperationType::WRITE), 'W');
     EXPECT_EQ(static_cast<char>(OperationType::UNLOCK), 'U');
     EXPECT_EQ(static_cast<char>(OperationType::EXIT), 'X');
+    EXPECT_EQ(static_cast<char>(OperationType::CONNECT), 'C');
+    EXPECT_EQ(static_cast<char>(OperationType::COMPARE_AND_SET), 'V');
+    EXPECT_EQ(static_cast<char>(OperationType::INSERT), 'I');
+    EXPECT_EQ(static_cast<char>(OperationType::DELETE), 'D');
+    EXPECT_EQ(static_cast<char>(OperationType::QUERY_NAME), 'Q');
+    EXPECT_EQ(static_cast<char>(OperationType::SCAN), 'S');
+    EXPECT_EQ(static_cast<char>(OperationType::AGGREGATE), 'G');
 }
 
 TEST(EmployeeTypesTest, ResponseStatusValues) {
@@ -65,12 +73,16 @@ TEST(EmployeeTypesTest, ResponseStatusValues) {
     EXPECT_EQ(static_cast<char>(ResponseStatus::ERROR), 'E');
     EXPECT_EQ(static_cast<char>(ResponseStatus::LOCKED), 'L');
     EXPECT_EQ(static_cast<char>(ResponseStatus::NOT_FOUND), 'N');
+    EXPECT_EQ(static_cast<char>(ResponseStatus::CONFLICT), 'C');
+    EXPECT_EQ(static_cast<char>(ResponseStatus::DUPLICATE), 'D');
 }
 
 TEST(EmployeeTypesTest, StructSizes) {
     EXPECT_EQ(sizeof(Employee), sizeof(int32_t) + 10 + sizeof(double));
-    EXPECT_EQ(sizeof(Request), sizeof(int32_t) * 2 + sizeof(OperationType) + sizeof(Employee) + sizeof(uint64_t));
-    EXPECT_EQ(sizeof(Response), sizeof(int32_t) + sizeof(ResponseStatus) + sizeof(Employee) + sizeof(uint64_t));
+    EXPECT_EQ(sizeof(Request), sizeof(int32_t) * 2 + sizeof(OperationType) + sizeof(Employee) + sizeof(uint64_t) * 2 +
+                               sizeof(uint32_t) * 3);
+    EXPECT_EQ(sizeof(Response), sizeof(int32_t) + sizeof(ResponseStatus) + sizeof(Employee) + sizeof(uint64_t) * 2 +
+                                sizeof(uint32_t) * 2);
 }
 
 TEST(EmployeeTypesTest, PackedAlignment) {
@@ -0,0 +1,101 @@
+#include "event_loop.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+namespace EmployeeSystem {
+
+class EventLoopTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::pipe(fds_), 0);
+    }
+    
+    void TearDown() override {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+    
+    int fds_[2] = {-1, -1};
+    EventLoop loop_;
+};
+
+TEST_F(EventLoopTest, DispatchesReadableDescriptor) {
+    ASSERT_TRUE(loop_.is_valid());
+    
+    std::string received;
+    ASSERT_TRUE(loop_.add(fds_[0], EventLoop::READABLE, [&](uint32_t events) {
+        EXPECT_TRUE(events & EventLoop::READABLE);
+        char buffer[16];
+        ssize_t n = ::read(fds_[0], buffer, sizeof(buffer));
+        received.append(buffer, n > 0 ? n : 0);
+    }));
+    
+    EXPECT_EQ(loop_.run_once(0), 0);
+    
+    ASSERT_EQ(::write(fds_[1], "ping", 4), 4);
+    EXPECT_EQ(loop_.run_once(1000), 1);
+    EXPECT_EQ(received, "ping");
+}
+
+TEST_F(EventLoopTest, ReportsHangupOfWriteEnd) {
+    bool hangup = false;
+    ASSERT_TRUE(loop_.add(fds_[1], 0, [&](uint32_t events) {
+        hangup = (events & EventLoop::HANGUP) != 0;
+    }));
+    
+    ::close(fds_[0]);
+    fds_[0] = -1;
+    
+    EXPECT_EQ(loop_.run_once(1000), 1);
+    EXPECT_TRUE(hangup);
+}
+
+TEST_F(EventLoopTest, RemovedDescriptorIsNotDispatched) {
+    int calls = 0;
+    ASSERT_TRUE(loop_.add(fds_[0], EventLoop::READABLE, [&](uint32_t) {
+        ++calls;
+        loop_.remove(fds_[0]);
+    }));
+    
+    ASSERT_EQ(::write(fds_[1], "xy", 2), 2);
+    EXPECT_EQ(loop_.run_once(1000), 1);
+    EXPECT_EQ(loop_.run_once(0), 0);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(EventLoopTest, WakeupInterruptsWait) {
+    std::thread waker([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop_.wakeup();
+    });
+    
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(loop_.run_once(5000), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    
+    waker.join();
+}
+
+TEST_F(EventLoopTest, ModifyTogglesWritableInterest) {
+    int writable = 0;
+    ASSERT_TRUE(loop_.add(fds_[1], 0, [&](uint32_t events) {
+        writable += (events & EventLoop::WRITABLE) != 0;
+    }));
+    
+    EXPECT_EQ(loop_.run_once(0), 0);
+    ASSERT_TRUE(loop_.modify(fds_[1], EventLoop::WRITABLE));
+    EXPECT_EQ(loop_.run_once(1000), 1);
+    EXPECT_EQ(writable, 1);
+    
+    ASSERT_TRUE(loop_.modify(fds_[1], 0, EventLoop::WRITABLE));
+    EXPECT_EQ(loop_.run_once(0), 0);
+    EXPECT_EQ(writable, 1);
+    EXPECT_FALSE(loop_.modify(fds_[0], EventLoop::WRITABLE));
+}
+
+}
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <thread>
 #include <chrono>
+#include <fcntl.h>
 using namespace EmployeeSystem;
 
 namespace EmployeeSystem {
@@ -191,4 +192,48 @@ TEST_F(FIFOManagerTest, BinaryDataTransfer) {
     EXPECT_STREQ(receive_data.name, send_data.name);
 }
 
+TEST_F(FIFOManagerTest, ChannelSendReceive) {
+    FIFOManager::create_fifo(test_fifo_path_);
+    
+    auto reader = FIFOManager::open_channel(test_fifo_path_, O_RDONLY);
+    ASSERT_NE(reader, nullptr);
+    auto writer = FIFOManager::open_channel(test_fifo_path_, O_WRONLY);
+    ASSERT_NE(writer, nullptr);
+    
+    for (int32_t i = 0; i < 3; ++i) {
+        Request sent;
+        sent.client_id = 7;
+        sent.employee_id = i;
+        ASSERT_TRUE(writer->send(&sent, sizeof(Request)));
+    }
+    
+    for (int32_t i = 0; i < 3; ++i) {
+        Request received;
+        ASSERT_TRUE(reader->receive(&received, sizeof(Request), 1000));
+        EXPECT_EQ(received.client_id, 7);
+        EXPECT_EQ(received.employee_id, i);
+    }
+}
+
+TEST_F(FIFOManagerTest, ChannelReceiveTimesOut) {
+    FIFOManager::create_fifo(test_fifo_path_);
+    
+    auto channel = FIFOManager::open_channel(test_fifo_path_, O_RDWR);
+    ASSERT_NE(channel, nullptr);
+    
+    Request req;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(channel->receive(&req, sizeof(Request), 50));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+}
+
+TEST_F(FIFOManagerTest, OpenChannelWithoutReaderFails) {
+    FIFOManager::create_fifo(test_fifo_path_);
+    EXPECT_EQ(FIFOManager::open_channel(test_fifo_path_, O_WRONLY), nullptr);
+}
+
+TEST_F(FIFOManagerTest, ClientFifoPath) {
+    EXPECT_EQ(FIFOManager::client_fifo_path(42), "/tmp/employee_client_42_fifo");
+}
+
 } 
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include "file_manager.h"
 #include <gtest/gtest.h>
+#include <csignal>
 #include <fstream>
 #include <filesystem>
 #include <thread>
 #include <atomic>
+#include <sys/resource.h>
 
 
 namespace EmployeeSystem {
@@ -19,6 +21,7 @@ protected:
         manager_->close();
         std::filesystem::remove(test_filename_);
         std::filesystem::remove(test_filename_ + ".tmp");
+        std::filesystem::remove(test_filename_ + ".wal");
     }
     
     void CreateTestFile(const std::vector<Employee>& employees) {
@@ -188,4 +191,423 @@ TEST_F(FileManagerTest, FileCorruptionRecovery) {
     EXPECT_TRUE(new_data[0] == employees[0]);
 }
 
+TEST_F(FileManagerTest, ReadEmployeeByIndex) {
+    std::vector<Employee> employees = {
+        Employee(10, "John", 40.0),
+        Employee(20, "Jane", 35.5),
+        Employee(30, "Bob", 42.0)
+    };
+    CreateTestFile(employees);
+    ASSERT_TRUE(manager_->open());
+    
+    EXPECT_EQ(manager_->size(), 3);
+    EXPECT_TRUE(manager_->contains(20));
+    EXPECT_FALSE(manager_->contains(99));
+    
+    Employee found;
+    ASSERT_TRUE(manager_->read_employee(30, found));
+    EXPECT_TRUE(found == employees[2]);
+    EXPECT_FALSE(manager_->read_employee(99, found));
+}
+
+TEST_F(FileManagerTest, UpdateEmployeeInPlace) {
+    std::vector<Employee> employees = {
+        Employee(1, "John", 40.0),
+        Employee(2, "Jane", 35.5),
+        Employee(3, "Bob", 42.0)
+    };
+    CreateTestFile(employees);
+    ASSERT_TRUE(manager_->open());
+    
+    Employee updated(2, "Janet", 50.0);
+    EXPECT_TRUE(manager_->update_employee(2, updated));
+    EXPECT_FALSE(manager_->update_employee(99, updated));
+    
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), 3 * sizeof(Employee));
+    EXPECT_FALSE(std::filesystem::exists(test_filename_ + ".tmp"));
+    
+    auto actual = manager_->read_all();
+    ASSERT_EQ(actual.size(), 3);
+    EXPECT_TRUE(actual[0] == employees[0]);
+    EXPECT_TRUE(actual[1] == updated);
+    EXPECT_TRUE(actual[2] == employees[2]);
+}
+
+TEST_F(FileManagerTest, UpdateEmployeeChangesId) {
+    std::vector<Employee> employees = {
+        Employee(1, "John", 40.0),
+        Employee(2, "Jane", 35.5)
+    };
+    CreateTestFile(employees);
+    ASSERT_TRUE(manager_->open());
+    
+    EXPECT_FALSE(manager_->update_employee(1, Employee(2, "Clash", 1.0)));
+    EXPECT_TRUE(manager_->update_employee(1, Employee(5, "John", 41.0)));
+    
+    Employee found;
+    EXPECT_FALSE(manager_->read_employee(1, found));
+    ASSERT_TRUE(manager_->read_employee(5, found));
+    EXPECT_DOUBLE_EQ(found.hours, 41.0);
+    EXPECT_TRUE(manager_->read_employee(2, found));
+}
+
+TEST_F(FileManagerTest, CompareAndUpdateChecksVersion) {
+    CreateTestFile({Employee(1, "John", 40.0), Employee(2, "Jane", 35.5)});
+    ASSERT_TRUE(manager_->open());
+    
+    Employee found;
+    uint64_t version = 0;
+    ASSERT_TRUE(manager_->read_employee(1, found, version));
+    EXPECT_NE(version, 0u);
+    
+    Employee current;
+    uint64_t next = 0;
+    EXPECT_EQ(manager_->compare_and_update(1, version, Employee(1, "Johnny", 41.0), current, next),
+              UpdateResult::APPLIED);
+    EXPECT_NE(next, version);
+    EXPECT_STREQ(current.name, "Johnny");
+    
+    uint64_t stale = version;
+    EXPECT_EQ(manager_->compare_and_update(1, stale, Employee(1, "Stale", 1.0), current, version),
+              UpdateResult::CONFLICT);
+    EXPECT_EQ(version, next);
+    EXPECT_STREQ(current.name, "Johnny");
+    
+    EXPECT_TRUE(manager_->update_employee(1, Employee(1, "Locked", 42.0)));
+    EXPECT_EQ(manager_->compare_and_update(1, next, Employee(1, "Lost", 2.0), current, version),
+              UpdateResult::CONFLICT);
+    EXPECT_STREQ(current.name, "Locked");
+    EXPECT_EQ(manager_->compare_and_update(99, version, current, current, version), UpdateResult::NOT_FOUND);
+    
+    uint64_t other = 0;
+    ASSERT_TRUE(manager_->read_employee(2, found, other));
+    EXPECT_NE(other, version);
+}
+
+TEST_F(FileManagerTest, VersionsDoNotSurviveReopen) {
+    CreateTestFile({Employee(1, "John", 40.0)});
+    ASSERT_TRUE(manager_->open());
+    
+    Employee found;
+    uint64_t before = 0;
+    ASSERT_TRUE(manager_->read_employee(1, found, before));
+    manager_->close();
+    ASSERT_TRUE(manager_->open());
+    
+    uint64_t after = 0;
+    Employee current;
+    ASSERT_TRUE(manager_->read_employee(1, found, after));
+    EXPECT_NE(before, after);
+    EXPECT_EQ(manager_->compare_and_update(1, before, found, current, after), UpdateResult::CONFLICT);
+}
+
+TEST_F(FileManagerTest, ModifyEmployeeAppliesUnderLock) {
+    CreateTestFile({Employee(1, "John", 40.0)});
+    ASSERT_TRUE(manager_->open());
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([this]() {
+            Employee current;
+            uint64_t version;
+            for (int i = 0; i < 250; ++i) {
+                manager_->modify_employee(1, [](Employee& employee) {
+                    employee.hours += 1.0;
+                    return true;
+                }, current, version);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    Employee current;
+    uint64_t version = 0;
+    uint64_t before = 0;
+    ASSERT_TRUE(manager_->read_employee(1, current, before));
+    EXPECT_DOUBLE_EQ(current.hours, 1040.0);
+    
+    EXPECT_EQ(manager_->modify_employee(1, [](Employee& employee) {
+        employee.hours = 0;
+        return false;
+    }, current, version), UpdateResult::CONFLICT);
+    EXPECT_EQ(version, before);
+    EXPECT_DOUBLE_EQ(current.hours, 1040.0);
+    EXPECT_EQ(manager_->modify_employee(7, [](Employee&) { return true; }, current, version),
+              UpdateResult::NOT_FOUND);
+}
+
+TEST_F(FileManagerTest, IndexFollowsWriteAll) {
+    ASSERT_TRUE(manager_->open());
+    
+    EXPECT_TRUE(manager_->write_all({Employee(7, "Seven", 7.0), Employee(8, "Eight", 8.0)}));
+    
+    Employee found;
+    ASSERT_TRUE(manager_->read_employee(8, found));
+    EXPECT_STREQ(found.name, "Eight");
+    
+    EXPECT_TRUE(manager_->write_all({Employee(9, "Nine", 9.0)}));
+    EXPECT_FALSE(manager_->contains(7));
+    EXPECT_TRUE(manager_->contains(9));
+    EXPECT_EQ(manager_->size(), 1);
+}
+
+TEST_F(FileManagerTest, MmapReadAndUpdate) {
+    std::vector<Employee> employees = {
+        Employee(1, "John", 40.0),
+        Employee(2, "Jane", 35.5)
+    };
+    CreateTestFile(employees);
+    
+    FileOptions options;
+    options.mode = StorageMode::MMAP;
+    FileManager mapped(test_filename_, options);
+    ASSERT_TRUE(mapped.open());
+    
+    Employee found;
+    ASSERT_TRUE(mapped.read_employee(2, found));
+    EXPECT_TRUE(found == employees[1]);
+    
+    EXPECT_TRUE(mapped.update_employee(1, Employee(1, "Johnny", 44.0)));
+    mapped.close();
+    
+    ASSERT_TRUE(manager_->open());
+    ASSERT_TRUE(manager_->read_employee(1, found));
+    EXPECT_STREQ(found.name, "Johnny");
+    EXPECT_DOUBLE_EQ(found.hours, 44.0);
+}
+
+TEST_F(FileManagerTest, MmapRemapsWhenFileGrows) {
+    FileOptions options;
+    options.mode = StorageMode::MMAP;
+    options.sync = SyncPolicy::SYNC;
+    FileManager mapped(test_filename_, options);
+    ASSERT_TRUE(mapped.open());
+    
+    EXPECT_TRUE(mapped.write_all({Employee(1, "Small", 1.0)}));
+    
+    std::vector<Employee> large;
+    for (int32_t id = 1; id <= 10000; ++id) {
+        large.emplace_back(id, "Emp" + std::to_string(id), id * 0.5);
+    }
+    EXPECT_TRUE(mapped.write_all(large));
+    EXPECT_EQ(mapped.size(), large.size());
+    
+    Employee found;
+    ASSERT_TRUE(mapped.read_employee(9999, found));
+    EXPECT_TRUE(found == large[9998]);
+    
+    EXPECT_TRUE(mapped.update_employee(10000, Employee(10000, "Last", 1.5)));
+    auto all = mapped.read_all();
+    ASSERT_EQ(all.size(), large.size());
+    EXPECT_STREQ(all.back().name, "Last");
+}
+
+TEST_F(FileManagerTest, InsertAndDeleteReuseFreeSlots) {
+    CreateTestFile({Employee(1, "John", 40.0), Employee(2, "Jane", 35.5)});
+    ASSERT_TRUE(manager_->open());
+    
+    uint64_t version = 0;
+    EXPECT_EQ(manager_->insert_employee(Employee(3, "Bob", 20.0), version), UpdateResult::APPLIED);
+    EXPECT_EQ(manager_->insert_employee(Employee(3, "Again", 1.0), version), UpdateResult::DUPLICATE);
+    EXPECT_EQ(manager_->insert_employee(Employee(TOMBSTONE_ID, "Bad", 1.0), version), UpdateResult::FAILED);
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), 3 * sizeof(Employee));
+    EXPECT_EQ(manager_->size(), 3);
+    
+    EXPECT_EQ(manager_->delete_employee(1), UpdateResult::APPLIED);
+    EXPECT_EQ(manager_->delete_employee(1), UpdateResult::NOT_FOUND);
+    EXPECT_FALSE(manager_->contains(1));
+    EXPECT_EQ(manager_->size(), 2);
+    EXPECT_EQ(manager_->read_all().size(), 2);
+    
+    EXPECT_EQ(manager_->insert_employee(Employee(4, "Dan", 10.0), version), UpdateResult::APPLIED);
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), 3 * sizeof(Employee));
+    auto all = manager_->read_all();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[0].id, 4);
+    
+    manager_->close();
+    ASSERT_TRUE(manager_->open());
+    EXPECT_EQ(manager_->delete_employee(2), UpdateResult::APPLIED);
+    manager_->close();
+    ASSERT_TRUE(manager_->open());
+    EXPECT_EQ(manager_->size(), 2);
+    EXPECT_EQ(manager_->insert_employee(Employee(5, "Eve", 5.0), version), UpdateResult::APPLIED);
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), 3 * sizeof(Employee));
+    Employee found;
+    ASSERT_TRUE(manager_->read_employee(5, found));
+    EXPECT_STREQ(found.name, "Eve");
+}
+
+TEST_F(FileManagerTest, MmapInsertGrowsFile) {
+    FileOptions options;
+    options.mode = StorageMode::MMAP;
+    options.wal = true;
+    FileManager mapped(test_filename_, options);
+    ASSERT_TRUE(mapped.open());
+    
+    uint64_t version = 0;
+    for (int32_t id = 1; id <= 3000; ++id) {
+        ASSERT_EQ(mapped.insert_employee(Employee(id, "Emp", id * 1.0), version), UpdateResult::APPLIED);
+    }
+    EXPECT_EQ(mapped.delete_employee(1500), UpdateResult::APPLIED);
+    EXPECT_EQ(mapped.size(), 2999);
+    
+    Employee found;
+    ASSERT_TRUE(mapped.read_employee(3000, found));
+    EXPECT_DOUBLE_EQ(found.hours, 3000.0);
+    mapped.close();
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), 3000 * sizeof(Employee));
+}
+
+TEST_F(FileManagerTest, ScanRangeReturnsLowestIdsInOrder) {
+    CreateTestFile({Employee(5, "E", 5.0), Employee(2, "B", 2.0), Employee(9, "I", 9.0),
+                    Employee(1, "A", 1.0), Employee(7, "G", 7.0)});
+    ASSERT_TRUE(manager_->open());
+    EXPECT_EQ(manager_->delete_employee(7), UpdateResult::APPLIED);
+    
+    std::vector<Employee> employees;
+    ASSERT_TRUE(manager_->scan_range(2, 100, 10, employees));
+    ASSERT_EQ(employees.size(), 3);
+    EXPECT_EQ(employees[0].id, 2);
+    EXPECT_EQ(employees[1].id, 5);
+    EXPECT_EQ(employees[2].id, 9);
+    
+    ASSERT_TRUE(manager_->scan_range(INT32_MIN + 1, INT32_MAX, 2, employees));
+    ASSERT_EQ(employees.size(), 2);
+    EXPECT_EQ(employees[0].id, 1);
+    EXPECT_EQ(employees[1].id, 2);
+    
+    size_t visited = 0;
+    EXPECT_TRUE(manager_->scan([&visited](const Employee&) { return ++visited < 2; }));
+    EXPECT_EQ(visited, 2);
+}
+
+TEST_F(FileManagerTest, AggregateHoursOverRange) {
+    std::vector<Employee> employees;
+    for (int32_t id = 1; id <= 10000; ++id) {
+        employees.emplace_back(id, "Emp", static_cast<double>(id % 100));
+    }
+    CreateTestFile(employees);
+    
+    for (StorageMode mode : {StorageMode::FILE_IO, StorageMode::MMAP}) {
+        FileOptions options;
+        options.mode = mode;
+        FileManager scanned(test_filename_, options);
+        ASSERT_TRUE(scanned.open());
+        
+        AggregateResult all;
+        ASSERT_TRUE(scanned.aggregate(INT32_MIN + 1, INT32_MAX, all));
+        EXPECT_EQ(all.count, 10000u);
+        EXPECT_DOUBLE_EQ(all.sum, 495000.0);
+        EXPECT_DOUBLE_EQ(all.min, 0.0);
+        EXPECT_DOUBLE_EQ(all.max, 99.0);
+        EXPECT_DOUBLE_EQ(all.avg, 49.5);
+        
+        AggregateResult range;
+        ASSERT_TRUE(scanned.aggregate(101, 110, range));
+        EXPECT_EQ(range.count, 10u);
+        EXPECT_DOUBLE_EQ(range.min, 1.0);
+        EXPECT_DOUBLE_EQ(range.max, 10.0);
+        
+        AggregateResult empty;
+        ASSERT_TRUE(scanned.aggregate(20000, 30000, empty));
+        EXPECT_EQ(empty.count, 0u);
+        EXPECT_DOUBLE_EQ(empty.avg, 0.0);
+    }
+}
+
+TEST_F(FileManagerTest, WalKeepsMainFileSizeAndCheckpoints) {
+    CreateTestFile({Employee(1, "John", 40.0), Employee(2, "Jane", 35.5)});
+    
+    FileOptions options;
+    options.wal = true;
+    options.checkpoint_interval = 4;
+    FileManager logged(test_filename_, options);
+    ASSERT_TRUE(logged.open());
+    
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(logged.update_employee(2, Employee(2, "Jane", 36.0 + i)));
+    }
+    EXPECT_EQ(std::filesystem::file_size(test_filename_ + ".wal"), 3 * sizeof(WalRecord));
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), 2 * sizeof(Employee));
+    
+    EXPECT_TRUE(logged.update_employee(1, Employee(1, "John", 41.0)));
+    EXPECT_EQ(std::filesystem::file_size(test_filename_ + ".wal"), 0);
+    
+    Employee found;
+    ASSERT_TRUE(logged.read_employee(2, found));
+    EXPECT_DOUBLE_EQ(found.hours, 38.0);
+}
+
+TEST_F(FileManagerTest, WalReplayedOnOpen) {
+    CreateTestFile({Employee(1, "John", 40.0), Employee(2, "Jane", 35.5)});
+    {
+        WriteAheadLog wal(test_filename_ + ".wal");
+        ASSERT_TRUE(wal.open());
+        wal.append(1, Employee(2, "Janet", 50.0));
+        wal.append(2, Employee(3, "Bob", 20.0));
+        ASSERT_TRUE(wal.flush());
+    }
+    
+    FileOptions options;
+    options.wal = true;
+    FileManager logged(test_filename_, options);
+    ASSERT_TRUE(logged.open());
+    
+    EXPECT_EQ(logged.size(), 3);
+    Employee found;
+    ASSERT_TRUE(logged.read_employee(2, found));
+    EXPECT_STREQ(found.name, "Janet");
+    ASSERT_TRUE(logged.read_employee(3, found));
+    EXPECT_DOUBLE_EQ(found.hours, 20.0);
+    EXPECT_EQ(std::filesystem::file_size(test_filename_ + ".wal"), 0);
+}
+
+TEST_F(FileManagerTest, WalDropsWritesThatFailToStore) {
+    std::vector<Employee> employees;
+    for (int id = 1; id <= 10; ++id) {
+        employees.emplace_back(id, "Emp", id);
+    }
+    CreateTestFile(employees);
+
+    FileOptions options;
+    options.wal = true;
+    options.checkpoint_interval = 2;
+    FileManager logged(test_filename_, options);
+    ASSERT_TRUE(logged.open());
+
+    struct rlimit saved;
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+    struct rlimit limit = saved;
+    limit.rlim_cur = employees.size() * sizeof(Employee);
+    auto previous = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+    uint64_t version = 0;
+    EXPECT_EQ(logged.insert_employee(Employee(11, "Ann", 1.0), version), UpdateResult::APPLIED);
+    EXPECT_EQ(logged.insert_employee(Employee(12, "Bob", 2.0), version), UpdateResult::APPLIED);
+    EXPECT_EQ(logged.insert_employee(Employee(13, "Cid", 3.0), version), UpdateResult::FAILED);
+
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &saved), 0);
+    std::signal(SIGXFSZ, previous);
+    EXPECT_FALSE(logged.contains(13));
+    EXPECT_EQ(std::filesystem::file_size(test_filename_), employees.size() * sizeof(Employee));
+
+    std::string crashed = test_filename_ + ".crash";
+    std::filesystem::copy_file(test_filename_, crashed, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::copy_file(test_filename_ + ".wal", crashed + ".wal",
+                               std::filesystem::copy_options::overwrite_existing);
+    {
+        FileManager recovered(crashed, options);
+        ASSERT_TRUE(recovered.open());
+        EXPECT_EQ(recovered.size(), 12u);
+        EXPECT_TRUE(recovered.contains(12));
+        EXPECT_FALSE(recovered.contains(13));
+    }
+    std::filesystem::remove(crashed);
+    std::filesystem::remove(crashed + ".wal");
+}
+
 } 
\ No newline at end of file
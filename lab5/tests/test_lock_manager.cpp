@@ -3,6 +3,7 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
 
 namespace EmployeeSystem {
 
@@ -132,4 +133,261 @@ TEST_F(LockManagerTest, ConcurrentAccessThreadSafety) {
     EXPECT_TRUE(lock_manager_.acquire_write_lock(EMPLOYEE_ID, NUM_THREADS + 1));
 }
 
-} 
\ No newline at end of file
+TEST_F(LockManagerTest, BlockingAcquireGrantedOnRelease) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    
+    std::thread releaser([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        lock_manager_.release_write_lock(1, 1);
+    });
+    
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(1, 2, std::chrono::milliseconds(2000)));
+    releaser.join();
+}
+
+TEST_F(LockManagerTest, BlockingAcquireTimesOut) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    
+    auto start = LockManager::Clock::now();
+    EXPECT_FALSE(lock_manager_.acquire_write_lock(1, 2, std::chrono::milliseconds(50)));
+    EXPECT_GE(LockManager::Clock::now() - start, std::chrono::milliseconds(50));
+    
+    lock_manager_.release_write_lock(1, 1);
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 2));
+}
+
+TEST_F(LockManagerTest, QueuedWriterBlocksNewReaders) {
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(1, 1));
+    
+    std::atomic<bool> writer_granted{false};
+    lock_manager_.acquire_lock_async(1, 2, true, std::chrono::milliseconds(5000),
+                                     [&writer_granted](bool granted) { writer_granted = granted; });
+    EXPECT_FALSE(writer_granted);
+    EXPECT_FALSE(lock_manager_.acquire_read_lock(1, 3));
+    
+    lock_manager_.release_read_lock(1, 1);
+    EXPECT_TRUE(writer_granted);
+    EXPECT_FALSE(lock_manager_.acquire_read_lock(1, 3));
+}
+
+TEST_F(LockManagerTest, AsyncAcquireGrantsInArrivalOrder) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    
+    std::vector<int> order;
+    for (int client = 2; client <= 4; ++client) {
+        lock_manager_.acquire_lock_async(1, client, true, std::chrono::milliseconds(5000),
+                                         [&order, client](bool granted) {
+            if (granted) {
+                order.push_back(client);
+            }
+        });
+    }
+    
+    lock_manager_.release_write_lock(1, 1);
+    lock_manager_.release_write_lock(1, 2);
+    lock_manager_.release_write_lock(1, 3);
+    EXPECT_EQ(order, (std::vector<int>{2, 3, 4}));
+}
+
+TEST_F(LockManagerTest, ExpireWaitersFailsOverdueCallbacks) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    
+    int result = -1;
+    lock_manager_.acquire_lock_async(1, 2, false, std::chrono::milliseconds(10),
+                                     [&result](bool granted) { result = granted ? 1 : 0; });
+    
+    LockManager::Clock::time_point deadline;
+    ASSERT_TRUE(lock_manager_.next_waiter_deadline(deadline));
+    EXPECT_EQ(lock_manager_.expire_waiters(deadline - std::chrono::milliseconds(1)), 0u);
+    EXPECT_EQ(result, -1);
+    
+    EXPECT_EQ(lock_manager_.expire_waiters(deadline), 1u);
+    EXPECT_EQ(result, 0);
+    EXPECT_FALSE(lock_manager_.next_waiter_deadline(deadline));
+}
+
+TEST_F(LockManagerTest, ReleaseAllLocksCancelsWaiters) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    
+    int second = -1;
+    int third = -1;
+    lock_manager_.acquire_lock_async(1, 2, true, std::chrono::milliseconds(5000),
+                                     [&second](bool granted) { second = granted ? 1 : 0; });
+    lock_manager_.acquire_lock_async(1, 3, true, std::chrono::milliseconds(5000),
+                                     [&third](bool granted) { third = granted ? 1 : 0; });
+    
+    lock_manager_.release_all_locks(2);
+    EXPECT_EQ(second, 0);
+    EXPECT_EQ(third, -1);
+    
+    lock_manager_.release_all_locks(1);
+    EXPECT_EQ(third, 1);
+}
+
+TEST_F(LockManagerTest, ManyEmployeesShareFewStripes) {
+    LockManager small(2);
+    constexpr int NUM_EMPLOYEES = 1000;
+    
+    for (int id = 0; id < NUM_EMPLOYEES; ++id) {
+        EXPECT_TRUE(small.acquire_write_lock(id, 1));
+    }
+    for (int id = 0; id < NUM_EMPLOYEES; ++id) {
+        EXPECT_FALSE(small.acquire_read_lock(id, 2));
+    }
+    
+    for (int id = 0; id < NUM_EMPLOYEES; id += 2) {
+        small.release_write_lock(id, 1);
+    }
+    for (int id = 0; id < NUM_EMPLOYEES; ++id) {
+        EXPECT_EQ(small.acquire_read_lock(id, 2), id % 2 == 0);
+    }
+    
+    small.release_all_locks(1);
+    small.release_all_locks(2);
+    for (int id = 0; id < NUM_EMPLOYEES; ++id) {
+        EXPECT_TRUE(small.acquire_write_lock(id, 3));
+    }
+}
+
+TEST_F(LockManagerTest, ManyReadersOverflowInlineSet) {
+    for (int client = 1; client <= 10; ++client) {
+        EXPECT_TRUE(lock_manager_.acquire_read_lock(1, client));
+    }
+    EXPECT_FALSE(lock_manager_.acquire_write_lock(1, 11));
+    
+    for (int client = 1; client <= 9; ++client) {
+        lock_manager_.release_read_lock(1, client);
+    }
+    EXPECT_FALSE(lock_manager_.acquire_write_lock(1, 11));
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 10));
+}
+
+TEST_F(LockManagerTest, OwnershipIndexTracksHeldAndWaitingLocks) {
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(1, 1));
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(2, 1));
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(1, 1));
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 2u);
+    
+    lock_manager_.acquire_lock_async(2, 2, false, std::chrono::milliseconds(5000), [](bool) {});
+    EXPECT_EQ(lock_manager_.owned_lock_count(2), 1u);
+    
+    lock_manager_.release_read_lock(1, 1);
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 1u);
+    
+    lock_manager_.release_all_locks(1);
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 0u);
+    EXPECT_EQ(lock_manager_.owned_lock_count(2), 1u);
+    EXPECT_FALSE(lock_manager_.acquire_write_lock(2, 3));
+    
+    lock_manager_.release_read_lock(2, 2);
+    EXPECT_EQ(lock_manager_.owned_lock_count(2), 0u);
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(2, 3));
+}
+
+TEST_F(LockManagerTest, ReleaseLocksIfKeepsUnselectedLocks) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(2, 1));
+    bool cancelled = false;
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(4, 2));
+    lock_manager_.acquire_lock_async(4, 1, true, std::chrono::milliseconds(5000),
+                                     [&cancelled](bool granted) { cancelled = !granted; });
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 3u);
+    
+    lock_manager_.release_locks_if(1, [](int32_t employee_id) { return employee_id % 2 == 0; });
+    EXPECT_TRUE(cancelled);
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 1u);
+    EXPECT_TRUE(lock_manager_.is_held_by(1, 1, true));
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(2, 3));
+    
+    lock_manager_.release_locks_if(1, [](int32_t) { return true; });
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 0u);
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 3));
+}
+
+TEST_F(LockManagerTest, ExpiredLeaseReleasesLocks) {
+    auto now = LockManager::Clock::now();
+    lock_manager_.set_lease_duration(std::chrono::milliseconds(100));
+    
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(2, 1));
+    EXPECT_EQ(lock_manager_.lease_count(), 1u);
+    
+    EXPECT_TRUE(lock_manager_.expire_leases(now + std::chrono::milliseconds(50)).empty());
+    EXPECT_FALSE(lock_manager_.acquire_write_lock(1, 2));
+    
+    auto reclaimed = lock_manager_.expire_leases(now + std::chrono::seconds(1));
+    EXPECT_EQ(reclaimed, std::vector<int32_t>{1});
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 0u);
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 2));
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(2, 2));
+}
+
+TEST_F(LockManagerTest, RenewedLeaseKeepsLocks) {
+    auto now = LockManager::Clock::now();
+    lock_manager_.set_lease_duration(std::chrono::milliseconds(100));
+    
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    lock_manager_.renew_lease(1, now + std::chrono::milliseconds(80));
+    
+    EXPECT_TRUE(lock_manager_.expire_leases(now + std::chrono::milliseconds(150)).empty());
+    EXPECT_EQ(lock_manager_.owned_lock_count(1), 1u);
+    
+    EXPECT_EQ(lock_manager_.expire_leases(now + std::chrono::milliseconds(300)), std::vector<int32_t>{1});
+    EXPECT_EQ(lock_manager_.lease_count(), 0u);
+}
+
+TEST_F(LockManagerTest, LockedByOthersIgnoresOwnLocks) {
+    EXPECT_FALSE(lock_manager_.is_locked_by_others(1, 1));
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(1, 1));
+    EXPECT_FALSE(lock_manager_.is_locked_by_others(1, 1));
+    EXPECT_TRUE(lock_manager_.is_locked_by_others(1, 2));
+    EXPECT_TRUE(lock_manager_.acquire_read_lock(1, 2));
+    EXPECT_TRUE(lock_manager_.is_locked_by_others(1, 1));
+    lock_manager_.release_read_lock(1, 2);
+    lock_manager_.release_read_lock(1, 1);
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 3));
+    EXPECT_FALSE(lock_manager_.is_locked_by_others(1, 3));
+    EXPECT_TRUE(lock_manager_.is_locked_by_others(1, 1));
+}
+
+TEST_F(LockManagerTest, LeasesDisabledByDefault) {
+    EXPECT_TRUE(lock_manager_.acquire_write_lock(1, 1));
+    EXPECT_EQ(lock_manager_.lease_count(), 0u);
+    EXPECT_TRUE(lock_manager_.expire_leases(LockManager::Clock::now() + std::chrono::hours(1)).empty());
+    EXPECT_FALSE(lock_manager_.acquire_write_lock(1, 2));
+}
+
+TEST_F(LockManagerTest, LeasedClientsLockConcurrently) {
+    constexpr int NUM_THREADS = 8;
+    constexpr int NUM_OPERATIONS = 20000;
+    lock_manager_.set_lease_duration(std::chrono::seconds(30));
+    
+    std::vector<std::thread> threads;
+    std::atomic<int> granted{0};
+    for (int thread_id = 0; thread_id < NUM_THREADS; ++thread_id) {
+        threads.emplace_back([this, thread_id, &granted]() {
+            int32_t client_id = thread_id + 1;
+            for (int i = 0; i < NUM_OPERATIONS; ++i) {
+                int32_t employee_id = thread_id * NUM_OPERATIONS + i % 256;
+                if (lock_manager_.acquire_write_lock(employee_id, client_id)) {
+                    ++granted;
+                }
+                lock_manager_.renew_lease(client_id);
+                lock_manager_.release_write_lock(employee_id, client_id);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(granted, NUM_THREADS * NUM_OPERATIONS);
+    EXPECT_EQ(lock_manager_.lease_count(), static_cast<size_t>(NUM_THREADS));
+    for (int32_t client_id = 1; client_id <= NUM_THREADS; ++client_id) {
+        EXPECT_EQ(lock_manager_.owned_lock_count(client_id), 0u);
+    }
+    EXPECT_TRUE(lock_manager_.expire_leases(LockManager::Clock::now() + std::chrono::minutes(1)).empty());
+    EXPECT_EQ(lock_manager_.lease_count(), 0u);
+}
+
+}
@@ -0,0 +1,171 @@
+#include "log_store.h"
+#include "file_manager.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+namespace EmployeeSystem {
+
+class LogStoreTest : public ::testing::Test {
+protected:
+    std::string base_ = "test_log_store.dat";
+
+    void SetUp() override {
+        remove_files();
+    }
+
+    void TearDown() override {
+        remove_files();
+    }
+
+    void remove_files() {
+        for (const auto& entry : std::filesystem::directory_iterator(".")) {
+            if (entry.path().filename().string().rfind(base_, 0) == 0) {
+                std::filesystem::remove(entry.path());
+            }
+        }
+    }
+
+    size_t segment_files() {
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(".")) {
+            std::string name = entry.path().filename().string();
+            count += name.rfind(base_, 0) == 0 && entry.path().extension() == ".seg";
+        }
+        return count;
+    }
+};
+
+TEST_F(LogStoreTest, ReadsLatestVersionAfterReopen) {
+    {
+        LogStore store(base_);
+        ASSERT_TRUE(store.open());
+        ASSERT_TRUE(store.append(0, Employee(1, "Ann", 1.0)));
+        ASSERT_TRUE(store.append(1, Employee(2, "Bob", 2.0)));
+        ASSERT_TRUE(store.append(0, Employee(1, "Anna", 3.0)));
+        EXPECT_EQ(store.slot_count(), 2u);
+        store.close();
+    }
+
+    LogStore store(base_);
+    ASSERT_TRUE(store.open());
+    Employee found;
+    ASSERT_TRUE(store.read(0, found));
+    EXPECT_STREQ(found.name, "Anna");
+    EXPECT_DOUBLE_EQ(found.hours, 3.0);
+    ASSERT_TRUE(store.read(1, found));
+    EXPECT_STREQ(found.name, "Bob");
+    EXPECT_FALSE(store.read(2, found));
+    EXPECT_EQ(store.stats().live, 2u);
+}
+
+TEST_F(LogStoreTest, CompactionDropsSupersededRecords) {
+    LogStore store(base_, 4);
+    ASSERT_TRUE(store.open());
+    for (int round = 0; round < 3; ++round) {
+        for (int slot = 0; slot < 4; ++slot) {
+            ASSERT_TRUE(store.append(slot, Employee(slot + 1, "Emp", round)));
+        }
+    }
+
+    ASSERT_TRUE(store.compact());
+    LogStore::Stats stats = store.stats();
+    EXPECT_EQ(stats.live, 4u);
+    EXPECT_EQ(stats.records, 4u);
+    EXPECT_EQ(stats.segments, 1u);
+    EXPECT_EQ(segment_files(), 1u);
+
+    store.close();
+    ASSERT_TRUE(store.open());
+    Employee found;
+    for (size_t slot = 0; slot < 4; ++slot) {
+        ASSERT_TRUE(store.read(slot, found));
+        EXPECT_DOUBLE_EQ(found.hours, 2.0);
+    }
+}
+
+TEST_F(LogStoreTest, CompactionMovesLiveRecordsOutOfSparseSegments) {
+    LogStore store(base_, 4);
+    ASSERT_TRUE(store.open());
+    for (int slot = 0; slot < 4; ++slot) {
+        ASSERT_TRUE(store.append(slot, Employee(slot + 1, "Old", 1.0)));
+    }
+    for (int slot = 0; slot < 3; ++slot) {
+        ASSERT_TRUE(store.append(slot, Employee(slot + 1, "New", 2.0)));
+    }
+    ASSERT_TRUE(store.append(0, Employee(1, "Newest", 3.0)));
+    ASSERT_TRUE(store.append(1, Employee(2, "Newest", 3.0)));
+
+    ASSERT_TRUE(store.compact());
+    EXPECT_EQ(store.stats().live, 4u);
+
+    store.close();
+    ASSERT_TRUE(store.open());
+    Employee found;
+    ASSERT_TRUE(store.read(3, found));
+    EXPECT_STREQ(found.name, "Old");
+    ASSERT_TRUE(store.read(2, found));
+    EXPECT_STREQ(found.name, "New");
+    ASSERT_TRUE(store.read(0, found));
+    EXPECT_STREQ(found.name, "Newest");
+}
+
+TEST_F(LogStoreTest, TruncatesTornTailOnOpen) {
+    {
+        LogStore store(base_);
+        ASSERT_TRUE(store.open());
+        ASSERT_TRUE(store.append(0, Employee(1, "Ann", 1.0)));
+        ASSERT_TRUE(store.append(1, Employee(2, "Bob", 2.0)));
+    }
+    {
+        std::ofstream segment(base_ + ".000001.seg", std::ios::binary | std::ios::app);
+        segment << "partial record";
+    }
+
+    LogStore store(base_);
+    ASSERT_TRUE(store.open());
+    EXPECT_EQ(store.slot_count(), 2u);
+    EXPECT_EQ(std::filesystem::file_size(base_ + ".000001.seg"), 2 * sizeof(LogRecord));
+    ASSERT_TRUE(store.append(2, Employee(3, "Cid", 3.0)));
+    Employee found;
+    ASSERT_TRUE(store.read(2, found));
+    EXPECT_STREQ(found.name, "Cid");
+}
+
+TEST_F(LogStoreTest, FileManagerRunsOnLogEngine) {
+    FileOptions options;
+    options.mode = StorageMode::LOG;
+    options.segment_records = 4;
+    {
+        FileManager manager(base_, options);
+        ASSERT_TRUE(manager.open());
+        ASSERT_TRUE(manager.write_all({Employee(1, "Ann", 1.0), Employee(2, "Bob", 2.0), Employee(3, "Cid", 3.0)}));
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(manager.update_employee(2, Employee(2, "Bob", 2.0 + i)));
+        }
+        uint64_t version = 0;
+        EXPECT_EQ(manager.insert_employee(Employee(4, "Dan", 4.0), version), UpdateResult::APPLIED);
+        EXPECT_EQ(manager.delete_employee(1), UpdateResult::APPLIED);
+        EXPECT_EQ(manager.insert_employee(Employee(5, "Eve", 5.0), version), UpdateResult::APPLIED);
+        EXPECT_EQ(manager.size(), 4u);
+        EXPECT_EQ(manager.log_stats().live, 4u);
+        manager.close();
+    }
+    EXPECT_FALSE(std::filesystem::exists(base_));
+
+    FileManager manager(base_, options);
+    ASSERT_TRUE(manager.open());
+    std::vector<Employee> employees = manager.read_all();
+    ASSERT_EQ(employees.size(), 4u);
+    EXPECT_EQ(employees[0].id, 5);
+    Employee found;
+    ASSERT_TRUE(manager.read_employee(2, found));
+    EXPECT_DOUBLE_EQ(found.hours, 11.0);
+    EXPECT_FALSE(manager.contains(1));
+
+    ASSERT_TRUE(manager.write_all({Employee(7, "Gus", 7.0)}));
+    EXPECT_EQ(segment_files(), 1u);
+    EXPECT_EQ(manager.read_all().size(), 1u);
+}
+
+}
@@ -0,0 +1,155 @@
+#include "logger.h"
+#include "mpsc_queue.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace EmployeeSystem {
+
+TEST(MpscQueueTest, PopsInPushOrderAndRejectsWhenFull) {
+    MpscQueue<int> queue(4);
+    EXPECT_EQ(queue.capacity(), 4u);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(int(i)));
+    }
+    EXPECT_FALSE(queue.try_push(99));
+
+    int value;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_TRUE(queue.try_push(5));
+}
+
+TEST(MpscQueueTest, ConcurrentProducersLoseNothing) {
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+    MpscQueue<int> queue(256);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                while (!queue.try_push(p * PER_PRODUCER + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::set<int> seen;
+    std::vector<int> last(NUM_PRODUCERS, -1);
+    int value;
+    while (seen.size() < static_cast<size_t>(NUM_PRODUCERS * PER_PRODUCER)) {
+        if (!queue.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / PER_PRODUCER;
+        EXPECT_GT(value, last[producer]);
+        last[producer] = value;
+        seen.insert(value);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::set_output(&output_);
+    }
+
+    void TearDown() override {
+        Logger::set_level(Logger::Level::DEBUG);
+        Logger::set_async(false);
+        Logger::set_output(nullptr);
+    }
+
+    std::ostringstream output_;
+};
+
+TEST_F(LoggerTest, SyncModeWritesImmediately) {
+    EXPECT_FALSE(Logger::is_async());
+    Logger::warn("sync message");
+    EXPECT_NE(output_.str().find("[WARN] sync message\n"), std::string::npos);
+    EXPECT_EQ(output_.str()[0], '[');
+}
+
+TEST_F(LoggerTest, AsyncModeDeliversEveryRecordOnFlush) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int PER_THREAD = 500;
+    Logger::set_async(true);
+    EXPECT_TRUE(Logger::is_async());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                Logger::info("thread " + std::to_string(t) + " record " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logger::flush();
+
+    std::istringstream lines(output_.str());
+    std::string line;
+    int records = 0;
+    while (std::getline(lines, line)) {
+        if (line.find("[INFO] thread ") != std::string::npos) {
+            ++records;
+        }
+    }
+    EXPECT_EQ(records + static_cast<int>(Logger::dropped()), NUM_THREADS * PER_THREAD);
+}
+
+TEST_F(LoggerTest, DisablingAsyncDrainsPendingRecords) {
+    Logger::set_async(true);
+    Logger::error("pending record");
+    Logger::set_async(false);
+    EXPECT_FALSE(Logger::is_async());
+    EXPECT_NE(output_.str().find("[ERROR] pending record\n"), std::string::npos);
+}
+
+TEST_F(LoggerTest, ThresholdFiltersBeforeMessageIsBuilt) {
+    int evaluations = 0;
+    auto message = [&evaluations]() {
+        ++evaluations;
+        return std::string("expensive message");
+    };
+
+    Logger::set_level(Logger::Level::WARN);
+    EXPECT_EQ(Logger::level(), Logger::Level::WARN);
+    EXPECT_FALSE(Logger::enabled(Logger::Level::INFO));
+    EMPLOYEE_LOG_DEBUG(message());
+    EMPLOYEE_LOG_INFO(message());
+    Logger::info("direct call below threshold");
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_TRUE(output_.str().empty());
+
+    EMPLOYEE_LOG_ERROR(message());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_NE(output_.str().find("[ERROR] expensive message"), std::string::npos);
+}
+
+TEST_F(LoggerTest, ParsesLevelNames) {
+    Logger::Level level;
+    ASSERT_TRUE(Logger::parse_level("warn", level));
+    EXPECT_EQ(level, Logger::Level::WARN);
+    ASSERT_TRUE(Logger::parse_level("debug", level));
+    EXPECT_EQ(level, Logger::Level::DEBUG);
+    EXPECT_FALSE(Logger::parse_level("verbose", level));
+}
+
+}
@@ -0,0 +1,120 @@
+#include "metrics.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace EmployeeSystem {
+
+TEST(LatencyHistogramTest, BucketsCoverValuesWithinBoundedError) {
+    size_t previous = 0;
+    for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 100ull, 1000ull, 123456ull, 1ull << 40}) {
+        size_t bucket = LatencyHistogram::bucket_for(value);
+        EXPECT_GE(bucket, previous);
+        EXPECT_LT(bucket, LatencyHistogram::BUCKETS);
+        uint64_t upper = LatencyHistogram::bucket_upper_bound(bucket);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / LatencyHistogram::SUB_BUCKETS + 1);
+        previous = bucket;
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_for(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+}
+
+TEST(LatencyHistogramTest, ReportsPercentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.99), 0u);
+
+    for (uint64_t micros = 1; micros <= 1000; ++micros) {
+        histogram.record(micros);
+    }
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.max(), 1000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+
+    uint64_t p50 = histogram.percentile(0.50);
+    uint64_t p99 = histogram.percentile(0.99);
+    EXPECT_GE(p50, 500u);
+    EXPECT_LE(p50, 500u + 500u / LatencyHistogram::SUB_BUCKETS);
+    EXPECT_GE(p99, 990u);
+    EXPECT_LE(p99, 1000u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreCounted) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                histogram.record(static_cast<uint64_t>(t * 100 + i % 50));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(histogram.count(), 40000u);
+    EXPECT_EQ(histogram.max(), 349u);
+}
+
+TEST(ServerMetricsTest, RecordsPerOperationAndPhase) {
+    ServerMetrics metrics;
+    metrics.record(OperationType::READ, Phase::IO, std::chrono::microseconds(40));
+    metrics.record(OperationType::READ, Phase::IO, std::chrono::microseconds(60));
+    metrics.record(OperationType::WRITE, Phase::LOCK_WAIT, std::chrono::milliseconds(3));
+    metrics.record(OperationType::CONNECT, Phase::TOTAL, std::chrono::microseconds(5));
+
+    EXPECT_EQ(metrics.histogram(OperationType::READ, Phase::IO)->count(), 2u);
+    EXPECT_EQ(metrics.histogram(OperationType::READ, Phase::TOTAL)->count(), 0u);
+    EXPECT_EQ(metrics.histogram(OperationType::WRITE, Phase::LOCK_WAIT)->max(), 3000u);
+    EXPECT_EQ(metrics.histogram(OperationType::CONNECT, Phase::TOTAL), nullptr);
+
+    LockManager::LockStats locks;
+    locks.contended = 7;
+    std::string report = metrics.report(locks);
+    EXPECT_NE(report.find("READ        io         count=2"), std::string::npos);
+    EXPECT_NE(report.find("WRITE       lock_wait  count=1"), std::string::npos);
+    EXPECT_EQ(report.find("UNLOCK"), std::string::npos);
+    EXPECT_NE(report.find("contended=7"), std::string::npos);
+}
+
+TEST(ServerMetricsTest, DumpReplacesFile) {
+    std::string path = "/tmp/employee_stats_" + std::to_string(getpid()) + ".txt";
+    ServerMetrics metrics;
+    metrics.record(OperationType::EXIT, Phase::TOTAL, std::chrono::microseconds(12));
+    ASSERT_TRUE(metrics.dump(path, LockManager::LockStats()));
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_NE(contents.str().find("EXIT"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
+
+TEST(LockStatsTest, CountsContentionDenialsAndTimeouts) {
+    LockManager locks;
+    ASSERT_TRUE(locks.acquire_write_lock(1, 1));
+    EXPECT_FALSE(locks.acquire_read_lock(1, 2));
+    EXPECT_FALSE(locks.acquire_write_lock(1, 3, std::chrono::milliseconds(20)));
+
+    bool granted = false;
+    locks.acquire_lock_async(1, 4, false, std::chrono::milliseconds(1000), [&granted](bool ok) { granted = ok; });
+    locks.release_write_lock(1, 1);
+    EXPECT_TRUE(granted);
+
+    LockManager::LockStats stats = locks.stats();
+    EXPECT_EQ(stats.acquired, 2u);
+    EXPECT_EQ(stats.contended, 3u);
+    EXPECT_EQ(stats.denied, 1u);
+    EXPECT_EQ(stats.timed_out, 1u);
+    locks.release_all_locks(4);
+}
+
+}
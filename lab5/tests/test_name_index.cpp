@@ -0,0 +1,65 @@
+#include "name_index.h"
+#include "file_manager.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+
+namespace EmployeeSystem {
+
+TEST(NameIndexTest, FindsExactAndPrefixMatches) {
+    NameIndex index;
+    index.put(3, "Anna");
+    index.put(1, "Ann");
+    index.put(2, "Bob");
+    index.put(4, "Ann");
+    EXPECT_EQ(index.size(), 4u);
+
+    EXPECT_EQ(index.find("Ann", false, 10), (std::vector<int32_t>{1, 4}));
+    EXPECT_EQ(index.find("An", true, 10), (std::vector<int32_t>{1, 4, 3}));
+    EXPECT_EQ(index.find("An", true, 2), (std::vector<int32_t>{1, 4}));
+    EXPECT_EQ(index.find("", true, 10).size(), 4u);
+    EXPECT_TRUE(index.find("C", true, 10).empty());
+    EXPECT_TRUE(index.find("An", false, 10).empty());
+}
+
+TEST(NameIndexTest, PutReplacesAndEraseRemoves) {
+    NameIndex index;
+    index.put(1, "Ann");
+    index.put(1, "Zed");
+    EXPECT_TRUE(index.find("Ann", false, 10).empty());
+    EXPECT_EQ(index.find("Zed", false, 10), (std::vector<int32_t>{1}));
+
+    index.erase(1);
+    index.erase(99);
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(index.find("", true, 10).empty());
+
+    char full[10] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J'};
+    EXPECT_EQ(NameIndex::key(full), "ABCDEFGHIJ");
+}
+
+TEST(NameIndexTest, FileManagerKeepsIndexInSync) {
+    std::string path = "test_name_index.dat";
+    {
+        FileManager manager(path);
+        ASSERT_TRUE(manager.open());
+        ASSERT_TRUE(manager.write_all({Employee(1, "Ann", 1.0), Employee(2, "Bob", 2.0)}));
+        EXPECT_EQ(manager.find_by_name("Ann", false, 10), (std::vector<int32_t>{1}));
+
+        ASSERT_TRUE(manager.update_employee(1, Employee(5, "Andy", 1.0)));
+        EXPECT_TRUE(manager.find_by_name("Ann", false, 10).empty());
+        EXPECT_EQ(manager.find_by_name("An", true, 10), (std::vector<int32_t>{5}));
+
+        uint64_t version;
+        EXPECT_EQ(manager.insert_employee(Employee(7, "Anne", 3.0), version), UpdateResult::APPLIED);
+        EXPECT_EQ(manager.delete_employee(2), UpdateResult::APPLIED);
+        EXPECT_TRUE(manager.find_by_name("Bob", false, 10).empty());
+        manager.close();
+
+        ASSERT_TRUE(manager.open());
+        EXPECT_EQ(manager.find_by_name("An", true, 10), (std::vector<int32_t>{5, 7}));
+        EXPECT_EQ(manager.find_by_name("", true, 10).size(), 2u);
+    }
+    std::filesystem::remove(path);
+}
+
+}
@@ -0,0 +1,164 @@
+#include "protocol.h"
+#include "fifo_manager.h"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <map>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace EmployeeSystem {
+
+TEST(ProtocolTest, RequestFrameRoundTrip) {
+    Request req;
+    req.client_id = 7;
+    req.operation = OperationType::BATCH_READ;
+    std::vector<int32_t> ids = {1, 2, 3};
+    
+    std::vector<char> frame;
+    ASSERT_TRUE(encode_request(req, ids.data(), ids.size() * sizeof(int32_t), frame));
+    EXPECT_EQ(frame.size(), sizeof(Request) + 3 * sizeof(int32_t));
+    
+    RequestReader reader;
+    reader.append(frame.data(), frame.size());
+    
+    Request decoded;
+    std::vector<char> payload;
+    ASSERT_TRUE(reader.next(decoded, payload));
+    EXPECT_EQ(decoded.client_id, 7);
+    EXPECT_EQ(decoded.operation, OperationType::BATCH_READ);
+    EXPECT_EQ(decoded.payload_length, 3 * sizeof(int32_t));
+    
+    std::vector<int32_t> decoded_ids;
+    ASSERT_TRUE(decode_items(payload, decoded_ids));
+    EXPECT_EQ(decoded_ids, ids);
+    EXPECT_FALSE(reader.next(decoded, payload));
+}
+
+TEST(ProtocolTest, ReaderWaitsForWholeFrames) {
+    Request req;
+    req.operation = OperationType::BATCH_WRITE;
+    BatchWriteItem item;
+    item.employee_id = 5;
+    item.employee = Employee(5, "Eve", 12.5);
+    
+    std::vector<char> frame;
+    ASSERT_TRUE(encode_request(req, &item, sizeof(item), frame));
+    std::vector<char> stream = frame;
+    Request plain;
+    plain.employee_id = 9;
+    std::vector<char> plain_frame;
+    ASSERT_TRUE(encode_request(plain, nullptr, 0, plain_frame));
+    stream.insert(stream.end(), plain_frame.begin(), plain_frame.end());
+    
+    RequestReader reader;
+    Request decoded;
+    std::vector<char> payload;
+    std::vector<Request> seen;
+    for (char byte : stream) {
+        reader.append(&byte, 1);
+        while (reader.next(decoded, payload)) {
+            seen.push_back(decoded);
+        }
+    }
+    
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[0].operation, OperationType::BATCH_WRITE);
+    EXPECT_EQ(seen[1].employee_id, 9);
+    EXPECT_TRUE(payload.empty());
+    EXPECT_EQ(reader.buffered(), 0u);
+}
+
+TEST(ProtocolTest, OversizedPayloadsAreRejected) {
+    std::vector<char> big(MAX_REQUEST_PAYLOAD + 1);
+    std::vector<char> frame;
+    EXPECT_FALSE(encode_request(Request(), big.data(), big.size(), frame));
+    
+    Request bogus;
+    bogus.payload_length = MAX_REQUEST_PAYLOAD + 1;
+    RequestReader reader;
+    reader.append(reinterpret_cast<const char*>(&bogus), sizeof(bogus));
+    
+    Request decoded;
+    std::vector<char> payload;
+    EXPECT_FALSE(reader.next(decoded, payload));
+    EXPECT_EQ(reader.dropped(), sizeof(bogus));
+    EXPECT_EQ(reader.buffered(), 0u);
+}
+
+TEST(ProtocolTest, BatchLimitsFitOneAtomicPipeWrite) {
+    EXPECT_LE(sizeof(Request) + MAX_BATCH_READ * sizeof(int32_t), MAX_REQUEST_FRAME);
+    EXPECT_LE(sizeof(Request) + MAX_BATCH_WRITE * sizeof(BatchWriteItem), MAX_REQUEST_FRAME);
+    EXPECT_LE(MAX_REQUEST_FRAME, static_cast<size_t>(PIPE_BUF));
+    EXPECT_GE(MAX_BATCH_READ, 100u);
+}
+
+TEST(ProtocolTest, ConcurrentWritersKeepFramesIntact) {
+    const std::string path = "/tmp/employee_protocol_test_fifo";
+    FIFOManager::remove_fifo(path);
+    ASSERT_TRUE(FIFOManager::create_fifo(path));
+    auto inbox = FIFOManager::open_channel(path, O_RDONLY | O_NONBLOCK);
+    ASSERT_TRUE(inbox);
+    
+    constexpr int WRITERS = 8;
+    constexpr int FRAMES = 200;
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < WRITERS; ++writer) {
+        writers.emplace_back([&path, writer]() {
+            auto channel = FIFOManager::open_channel(path, O_WRONLY);
+            ASSERT_TRUE(channel);
+            std::vector<int32_t> ids(MAX_BATCH_READ, writer);
+            for (int i = 0; i < FRAMES; ++i) {
+                Request req;
+                req.client_id = writer;
+                req.employee_id = i;
+                req.operation = OperationType::BATCH_READ;
+                std::vector<char> frame;
+                ASSERT_TRUE(encode_request(req, ids.data(), ids.size() * sizeof(int32_t), frame));
+                ASSERT_TRUE(channel->send(frame.data(), frame.size()));
+            }
+        });
+    }
+    
+    RequestReader reader;
+    std::map<int32_t, int32_t> next_frame;
+    int received = 0;
+    char buffer[MAX_REQUEST_FRAME];
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received < WRITERS * FRAMES && std::chrono::steady_clock::now() < deadline) {
+        ssize_t n = ::read(inbox->fd(), buffer, sizeof(buffer));
+        if (n <= 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        reader.append(buffer, static_cast<size_t>(n));
+        
+        Request req;
+        std::vector<char> payload;
+        std::vector<int32_t> ids;
+        while (reader.next(req, payload)) {
+            ASSERT_TRUE(decode_items(payload, ids));
+            ASSERT_EQ(ids.size(), MAX_BATCH_READ);
+            EXPECT_EQ(ids.front(), req.client_id);
+            EXPECT_EQ(ids.back(), req.client_id);
+            EXPECT_EQ(req.employee_id, next_frame[req.client_id]++);
+            ++received;
+        }
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    
+    EXPECT_EQ(received, WRITERS * FRAMES);
+    EXPECT_EQ(reader.dropped(), 0u);
+    inbox.reset();
+    FIFOManager::remove_fifo(path);
+}
+
+TEST(ProtocolTest, DecodeItemsRejectsPartialItems) {
+    std::vector<char> payload(sizeof(BatchResult) + 1);
+    std::vector<BatchResult> results;
+    EXPECT_FALSE(decode_items(payload, results));
+}
+
+}
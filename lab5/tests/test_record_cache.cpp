@@ -0,0 +1,140 @@
+#include "record_cache.h"
+#include "file_manager.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace EmployeeSystem {
+
+TEST(RecordCacheTest, EvictsLeastRecentlyUsed) {
+    RecordCache cache(2, [](size_t, const Employee&) { return true; });
+    Employee found;
+    EXPECT_FALSE(cache.lookup(1, found));
+
+    ASSERT_TRUE(cache.fill(1, Employee(1, "One", 1.0)));
+    ASSERT_TRUE(cache.fill(2, Employee(2, "Two", 2.0)));
+    EXPECT_TRUE(cache.lookup(1, found));
+    ASSERT_TRUE(cache.fill(3, Employee(3, "Three", 3.0)));
+
+    EXPECT_FALSE(cache.lookup(2, found));
+    EXPECT_TRUE(cache.lookup(1, found));
+    EXPECT_STREQ(found.name, "One");
+    EXPECT_TRUE(cache.lookup(3, found));
+
+    RecordCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 3u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.size, 2u);
+    EXPECT_EQ(stats.capacity, 2u);
+}
+
+TEST(RecordCacheTest, WritesBackDirtyEntriesOnEvictionAndFlush) {
+    std::map<size_t, Employee> disk;
+    RecordCache cache(2, [&disk](size_t slot, const Employee& employee) {
+        disk[slot] = employee;
+        return true;
+    });
+
+    ASSERT_TRUE(cache.put(0, Employee(1, "Dirty", 1.0), true));
+    ASSERT_TRUE(cache.fill(0, Employee(1, "Stale", 0.0)));
+    ASSERT_TRUE(cache.put(1, Employee(2, "Clean", 2.0), false));
+    EXPECT_EQ(cache.stats().dirty, 1u);
+    EXPECT_TRUE(disk.empty());
+
+    ASSERT_TRUE(cache.put(2, Employee(3, "New", 3.0), true));
+    ASSERT_EQ(disk.size(), 1u);
+    EXPECT_STREQ(disk[0].name, "Dirty");
+
+    ASSERT_TRUE(cache.flush());
+    EXPECT_STREQ(disk[2].name, "New");
+    EXPECT_EQ(cache.stats().dirty, 0u);
+    EXPECT_EQ(cache.stats().write_backs, 2u);
+}
+
+TEST(RecordCacheTest, FailedWriteBackKeepsEntryDirty) {
+    bool fail = true;
+    RecordCache cache(1, [&fail](size_t, const Employee&) { return !fail; });
+    ASSERT_TRUE(cache.put(0, Employee(1, "Dirty", 1.0), true));
+    EXPECT_FALSE(cache.put(1, Employee(2, "Next", 2.0), false));
+    EXPECT_FALSE(cache.flush());
+
+    Employee found;
+    EXPECT_TRUE(cache.lookup(0, found));
+    fail = false;
+    EXPECT_TRUE(cache.flush());
+    EXPECT_EQ(cache.stats().dirty, 0u);
+}
+
+TEST(RecordCacheTest, FillNeverWritesBackDirtyEntries) {
+    size_t write_backs = 0;
+    RecordCache cache(2, [&write_backs](size_t, const Employee&) {
+        ++write_backs;
+        return true;
+    });
+    ASSERT_TRUE(cache.put(0, Employee(1, "Dirty", 1.0), true));
+    ASSERT_TRUE(cache.fill(1, Employee(2, "Clean", 2.0)));
+    ASSERT_TRUE(cache.fill(2, Employee(3, "Newer", 3.0)));
+
+    Employee found;
+    EXPECT_FALSE(cache.lookup(1, found));
+    EXPECT_TRUE(cache.lookup(0, found));
+    ASSERT_TRUE(cache.put(2, Employee(3, "Dirty", 3.0), true));
+    ASSERT_TRUE(cache.fill(3, Employee(4, "Skipped", 4.0)));
+    EXPECT_FALSE(cache.lookup(3, found));
+    EXPECT_EQ(write_backs, 0u);
+    EXPECT_EQ(cache.dirty_entries().size(), 2u);
+    EXPECT_EQ(cache.stats().size, 2u);
+}
+
+TEST(RecordCacheTest, FileManagerWriteBackDefersDiskWrites) {
+    std::string path = "test_record_cache.dat";
+    {
+        std::ofstream file(path, std::ios::binary);
+        Employee employees[] = {Employee(1, "Ann", 1.0), Employee(2, "Bob", 2.0), Employee(3, "Cid", 3.0)};
+        file.write(reinterpret_cast<const char*>(employees), sizeof(employees));
+    }
+
+    FileOptions options;
+    options.cache_records = 2;
+    options.cache_policy = CachePolicy::WRITE_BACK;
+    FileManager manager(path, options);
+    ASSERT_TRUE(manager.open());
+
+    Employee found;
+    ASSERT_TRUE(manager.read_employee(1, found));
+    ASSERT_TRUE(manager.read_employee(1, found));
+    EXPECT_TRUE(manager.update_employee(2, Employee(2, "Bobby", 5.0)));
+
+    Employee on_disk;
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.seekg(sizeof(Employee));
+        file.read(reinterpret_cast<char*>(&on_disk), sizeof(on_disk));
+    }
+    EXPECT_STREQ(on_disk.name, "Bob");
+
+    ASSERT_TRUE(manager.read_employee(2, found));
+    EXPECT_STREQ(found.name, "Bobby");
+    AggregateResult result;
+    ASSERT_TRUE(manager.aggregate(1, 3, result));
+    EXPECT_DOUBLE_EQ(result.sum, 9.0);
+
+    EXPECT_EQ(manager.read_all()[1], Employee(2, "Bobby", 5.0));
+
+    RecordCache::Stats stats = manager.cache_stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.dirty, 1u);
+    EXPECT_EQ(stats.write_backs, 0u);
+
+    manager.close();
+    ASSERT_TRUE(manager.open());
+    ASSERT_TRUE(manager.read_employee(2, found));
+    EXPECT_STREQ(found.name, "Bobby");
+    manager.close();
+    std::filesystem::remove(path);
+}
+
+}
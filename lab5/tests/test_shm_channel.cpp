@@ -0,0 +1,131 @@
+#include "shm_channel.h"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace EmployeeSystem {
+
+class ShmChannelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        name_ = "/employee_test_shm_" + std::to_string(getpid());
+    }
+    
+    std::string name_;
+};
+
+TEST_F(ShmChannelTest, AttachFailsWithoutSegment) {
+    EXPECT_EQ(ShmChannel::attach(name_), nullptr);
+}
+
+TEST_F(ShmChannelTest, MessagesFlowInBothDirections) {
+    auto client = ShmChannel::create(name_);
+    ASSERT_NE(client, nullptr);
+    auto server = ShmChannel::attach(name_);
+    ASSERT_NE(server, nullptr);
+    
+    Request req;
+    req.client_id = 4;
+    req.employee_id = 17;
+    req.operation = OperationType::WRITE;
+    ASSERT_TRUE(client->send(&req, sizeof(req)));
+    
+    Request received;
+    ASSERT_TRUE(server->receive(&received, sizeof(received), 1000));
+    EXPECT_EQ(received.client_id, 4);
+    EXPECT_EQ(received.employee_id, 17);
+    
+    Response resp;
+    resp.status = ResponseStatus::SUCCESS;
+    resp.employee = Employee(17, "Shm", 3.5);
+    ASSERT_TRUE(server->send(&resp, sizeof(resp)));
+    
+    Response answer;
+    ASSERT_TRUE(client->receive(&answer, sizeof(answer), 1000));
+    EXPECT_EQ(answer.status, ResponseStatus::SUCCESS);
+    EXPECT_EQ(answer.employee, resp.employee);
+    EXPECT_TRUE(server->peer_alive());
+}
+
+TEST_F(ShmChannelTest, ReceiveTimesOutWhenEmpty) {
+    auto client = ShmChannel::create(name_);
+    ASSERT_NE(client, nullptr);
+    
+    Response resp;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(client->receive(&resp, sizeof(resp), 50));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(ShmChannelTest, LargeTransfersWrapAroundTheRing) {
+    auto client = ShmChannel::create(name_, 4096);
+    ASSERT_NE(client, nullptr);
+    auto server = ShmChannel::attach(name_);
+    ASSERT_NE(server, nullptr);
+    
+    std::vector<int32_t> sent(100000);
+    std::iota(sent.begin(), sent.end(), 0);
+    
+    std::thread writer([&]() {
+        for (size_t i = 0; i < sent.size(); i += 1000) {
+            ASSERT_TRUE(client->send(sent.data() + i, 1000 * sizeof(int32_t)));
+        }
+    });
+    
+    std::vector<int32_t> received(sent.size());
+    for (size_t i = 0; i < received.size(); i += 500) {
+        ASSERT_TRUE(server->receive(received.data() + i, 500 * sizeof(int32_t), 2000));
+    }
+    writer.join();
+    EXPECT_EQ(received, sent);
+}
+
+TEST_F(ShmChannelTest, CloseWakesBlockedReader) {
+    auto client = ShmChannel::create(name_);
+    ASSERT_NE(client, nullptr);
+    auto server = ShmChannel::attach(name_);
+    ASSERT_NE(server, nullptr);
+    
+    std::thread closer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        client->close();
+    });
+    
+    Request req;
+    EXPECT_FALSE(server->receive(&req, sizeof(req)));
+    EXPECT_TRUE(server->closed());
+    closer.join();
+}
+
+TEST_F(ShmChannelTest, QueuedSendsDoNotBlockOnFullRing) {
+    auto client = ShmChannel::create(name_, 4096);
+    ASSERT_NE(client, nullptr);
+    auto server = ShmChannel::attach(name_);
+    ASSERT_NE(server, nullptr);
+    
+    std::vector<char> sent(3 * 4096);
+    std::iota(sent.begin(), sent.end(), 0);
+    EXPECT_EQ(server->send_queued(sent.data(), sent.size()), SendResult::QUEUED);
+    Channel::Clock::time_point since;
+    EXPECT_TRUE(server->blocked_since(since));
+    
+    Request req;
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_FALSE(server->receive(&req, sizeof(req), 5000));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+    
+    std::vector<char> received(sent.size());
+    size_t done = 0;
+    while (done < received.size()) {
+        server->flush();
+        ASSERT_TRUE(client->receive(received.data() + done, 1024, 2000));
+        done += 1024;
+    }
+    EXPECT_EQ(server->flush(), SendResult::SENT);
+    EXPECT_FALSE(server->blocked_since(since));
+    EXPECT_EQ(received, sent);
+}
+
+}
@@ -0,0 +1,174 @@
+#include "socket_channel.h"
+#include "protocol.h"
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <filesystem>
+#include <numeric>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace EmployeeSystem {
+
+class SocketChannelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = "/tmp/employee_test_sock_" + std::to_string(getpid());
+        listener_ = SocketListener::listen(path_);
+        ASSERT_NE(listener_, nullptr);
+    }
+
+    std::unique_ptr<SocketChannel> AcceptOne() {
+        for (int i = 0; i < 100; ++i) {
+            if (auto channel = listener_->accept()) {
+                return channel;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return nullptr;
+    }
+
+    std::string path_;
+    std::unique_ptr<SocketListener> listener_;
+};
+
+TEST_F(SocketChannelTest, ConnectFailsWithoutListener) {
+    listener_.reset();
+    EXPECT_FALSE(std::filesystem::exists(path_));
+    EXPECT_EQ(SocketChannel::connect(path_), nullptr);
+}
+
+TEST_F(SocketChannelTest, AcceptReturnsNullWhenIdle) {
+    EXPECT_EQ(listener_->accept(), nullptr);
+}
+
+TEST_F(SocketChannelTest, FramesFlowInBothDirections) {
+    auto client = SocketChannel::connect(path_);
+    ASSERT_NE(client, nullptr);
+    auto server = AcceptOne();
+    ASSERT_NE(server, nullptr);
+
+    Request req;
+    req.client_id = 6;
+    req.employee_id = 21;
+    req.operation = OperationType::BATCH_READ;
+    std::vector<int32_t> ids = {1, 2, 3};
+    std::vector<char> frame;
+    ASSERT_TRUE(encode_request(req, ids.data(), ids.size() * sizeof(int32_t), frame));
+    ASSERT_TRUE(client->send(frame.data(), frame.size()));
+
+    char packet[SocketChannel::MAX_PACKET];
+    ssize_t n = -1;
+    for (int i = 0; i < 100 && n < 0; ++i) {
+        n = server->receive_packet(packet, sizeof(packet));
+        if (n < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    ASSERT_EQ(n, static_cast<ssize_t>(frame.size()));
+
+    RequestReader reader;
+    reader.append(packet, static_cast<size_t>(n));
+    Request received;
+    std::vector<char> payload;
+    ASSERT_TRUE(reader.next(received, payload));
+    EXPECT_EQ(received.employee_id, 21);
+    EXPECT_EQ(payload.size(), ids.size() * sizeof(int32_t));
+
+    Response resp;
+    resp.status = ResponseStatus::SUCCESS;
+    resp.employee = Employee(21, "Sock", 4.5);
+    ASSERT_TRUE(server->send(&resp, sizeof(resp)));
+
+    Response answer;
+    ASSERT_TRUE(client->receive(&answer, sizeof(answer), 1000));
+    EXPECT_EQ(answer.status, ResponseStatus::SUCCESS);
+    EXPECT_EQ(answer.employee, resp.employee);
+}
+
+TEST_F(SocketChannelTest, LargeMessagesSpanPackets) {
+    auto client = SocketChannel::connect(path_);
+    ASSERT_NE(client, nullptr);
+    auto server = AcceptOne();
+    ASSERT_NE(server, nullptr);
+
+    std::vector<int32_t> sent(100000);
+    std::iota(sent.begin(), sent.end(), 0);
+    std::thread writer([&]() {
+        ASSERT_TRUE(server->send(sent.data(), sent.size() * sizeof(int32_t)));
+    });
+
+    std::vector<int32_t> received(sent.size());
+    for (size_t i = 0; i < received.size(); i += 1000) {
+        ASSERT_TRUE(client->receive(received.data() + i, 1000 * sizeof(int32_t), 2000));
+    }
+    writer.join();
+    EXPECT_EQ(received, sent);
+}
+
+TEST_F(SocketChannelTest, PeerCloseIsReportedImmediately) {
+    auto client = SocketChannel::connect(path_);
+    ASSERT_NE(client, nullptr);
+    auto server = AcceptOne();
+    ASSERT_NE(server, nullptr);
+
+    client.reset();
+    char packet[64];
+    EXPECT_EQ(server->receive_packet(packet, sizeof(packet)), 0);
+
+    Response resp;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(server->receive(&resp, sizeof(resp), 2000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+}
+
+TEST_F(SocketChannelTest, QueuedSendDoesNotBlockOnIdleReader) {
+    auto client = SocketChannel::connect(path_);
+    ASSERT_NE(client, nullptr);
+    auto server = AcceptOne();
+    ASSERT_NE(server, nullptr);
+
+    std::vector<int32_t> chunk(1024);
+    std::iota(chunk.begin(), chunk.end(), 0);
+    size_t chunk_bytes = chunk.size() * sizeof(int32_t);
+    size_t sent = 0;
+    SendResult result = SendResult::SENT;
+    auto start = std::chrono::steady_clock::now();
+    while (result == SendResult::SENT && sent < 64 * 1024 * 1024) {
+        result = server->send_queued(chunk.data(), chunk_bytes);
+        sent += chunk_bytes;
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    ASSERT_EQ(result, SendResult::QUEUED);
+    Channel::Clock::time_point since;
+    EXPECT_TRUE(server->blocked_since(since));
+    EXPECT_EQ(server->send_queued(chunk.data(), chunk_bytes), SendResult::QUEUED);
+    sent += chunk_bytes;
+
+    std::vector<int32_t> received(chunk.size());
+    for (size_t done = 0; done < sent; done += chunk_bytes) {
+        ASSERT_TRUE(client->receive(received.data(), chunk_bytes, 2000));
+        ASSERT_EQ(received, chunk);
+        result = server->flush();
+        ASSERT_NE(result, SendResult::FAILED);
+    }
+    EXPECT_EQ(result, SendResult::SENT);
+    EXPECT_FALSE(server->blocked_since(since));
+}
+
+TEST_F(SocketChannelTest, QueuedSendFailsOnceBacklogOverflows) {
+    auto client = SocketChannel::connect(path_);
+    ASSERT_NE(client, nullptr);
+    auto server = AcceptOne();
+    ASSERT_NE(server, nullptr);
+
+    std::vector<char> frame(MAX_RESPONSE_PAYLOAD);
+    SendResult result = SendResult::SENT;
+    for (size_t i = 0; i < 64 && result != SendResult::FAILED; ++i) {
+        result = server->send_queued(frame.data(), frame.size());
+    }
+    EXPECT_EQ(result, SendResult::FAILED);
+    EXPECT_EQ(server->flush(), SendResult::FAILED);
+}
+
+}
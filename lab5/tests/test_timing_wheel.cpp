@@ -0,0 +1,74 @@
+#include "timing_wheel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace EmployeeSystem {
+
+using std::chrono::milliseconds;
+
+class TimingWheelTest : public ::testing::Test {
+protected:
+    TimingWheel::Clock::time_point origin_ = TimingWheel::Clock::now();
+    TimingWheel wheel_{milliseconds(10), origin_};
+    
+    std::vector<int32_t> advance_to(milliseconds offset) {
+        std::vector<int32_t> expired;
+        wheel_.advance(origin_ + offset, expired);
+        return expired;
+    }
+};
+
+TEST_F(TimingWheelTest, FiresAfterDeadline) {
+    wheel_.schedule(1, origin_ + milliseconds(50));
+    EXPECT_EQ(wheel_.size(), 1u);
+    
+    EXPECT_TRUE(advance_to(milliseconds(40)).empty());
+    EXPECT_EQ(advance_to(milliseconds(70)), std::vector<int32_t>{1});
+    EXPECT_EQ(wheel_.size(), 0u);
+}
+
+TEST_F(TimingWheelTest, CascadesLongTimersThroughLevels) {
+    wheel_.schedule(1, origin_ + milliseconds(2000));
+    wheel_.schedule(2, origin_ + milliseconds(700000));
+    wheel_.schedule(3, origin_ + milliseconds(30));
+    
+    EXPECT_EQ(advance_to(milliseconds(100)), std::vector<int32_t>{3});
+    EXPECT_TRUE(advance_to(milliseconds(1990)).empty());
+    EXPECT_EQ(advance_to(milliseconds(2020)), std::vector<int32_t>{1});
+    EXPECT_TRUE(advance_to(milliseconds(699990)).empty());
+    EXPECT_EQ(advance_to(milliseconds(700020)), std::vector<int32_t>{2});
+}
+
+TEST_F(TimingWheelTest, ExpiresManyTimersInOneAdvance) {
+    for (int32_t key = 0; key < 500; ++key) {
+        wheel_.schedule(key, origin_ + milliseconds(key * 7));
+    }
+    
+    auto expired = advance_to(milliseconds(10000));
+    EXPECT_EQ(expired.size(), 500u);
+    std::sort(expired.begin(), expired.end());
+    for (int32_t key = 0; key < 500; ++key) {
+        EXPECT_EQ(expired[key], key);
+    }
+}
+
+TEST_F(TimingWheelTest, PastDeadlineFiresOnNextTick) {
+    advance_to(milliseconds(1000));
+    wheel_.schedule(1, origin_);
+    EXPECT_EQ(advance_to(milliseconds(1030)), std::vector<int32_t>{1});
+}
+
+TEST_F(TimingWheelTest, FiresExactlyAtLevelBoundary) {
+    wheel_.schedule(1, origin_ + milliseconds(630));
+    wheel_.schedule(2, origin_ + milliseconds(40950));
+    
+    EXPECT_TRUE(advance_to(milliseconds(630)).empty());
+    EXPECT_EQ(advance_to(milliseconds(640)), std::vector<int32_t>{1});
+    EXPECT_TRUE(advance_to(milliseconds(40950)).empty());
+    EXPECT_EQ(advance_to(milliseconds(40960)), std::vector<int32_t>{2});
+    EXPECT_EQ(wheel_.size(), 0u);
+}
+
+}
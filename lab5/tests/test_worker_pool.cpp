@@ -0,0 +1,122 @@
+#include "worker_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace EmployeeSystem {
+
+TEST(WorkerPoolTest, RunsAllSubmittedTasks) {
+    std::atomic<int> executed{0};
+    {
+        WorkerPool pool(4);
+        EXPECT_EQ(pool.size(), 4);
+        for (int32_t i = 0; i < 1000; ++i) {
+            pool.submit(i, [&executed]() { executed++; });
+        }
+        pool.stop();
+    }
+    EXPECT_EQ(executed, 1000);
+}
+
+TEST(WorkerPoolTest, ZeroWorkersFallsBackToOne) {
+    WorkerPool pool(0);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(WorkerPoolTest, SameKeyKeepsSubmissionOrder) {
+    WorkerPool pool(4);
+    std::mutex mutex;
+    std::vector<int> order;
+    
+    for (int i = 0; i < 200; ++i) {
+        pool.submit(42, [&mutex, &order, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+        });
+    }
+    pool.stop();
+    
+    ASSERT_EQ(order.size(), 200);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(WorkerPoolTest, BlockedShardDoesNotStallOthers) {
+    WorkerPool pool(4);
+    
+    int32_t blocked_key = 1;
+    int32_t other_key = 2;
+    while (pool.shard_for(other_key) == pool.shard_for(blocked_key)) {
+        ++other_key;
+    }
+    
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> other_done;
+    
+    pool.submit(blocked_key, [released]() { released.wait(); });
+    pool.submit(other_key, [&other_done]() { other_done.set_value(); });
+    
+    EXPECT_EQ(other_done.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    release.set_value();
+}
+
+TEST(WorkerPoolTest, SubmitToRunsOnChosenShard) {
+    WorkerPool pool(4);
+    std::mutex mutex;
+    std::vector<std::thread::id> threads(pool.size());
+    std::promise<void> done;
+    std::atomic<size_t> remaining{pool.size() * 2};
+    
+    for (size_t round = 0; round < 2; ++round) {
+        for (size_t shard = 0; shard < pool.size(); ++shard) {
+            pool.submit_to(shard, [&, shard]() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (threads[shard] == std::thread::id()) {
+                        threads[shard] = std::this_thread::get_id();
+                    }
+                    EXPECT_EQ(threads[shard], std::this_thread::get_id());
+                }
+                if (--remaining == 0) {
+                    done.set_value();
+                }
+            });
+        }
+    }
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    for (size_t i = 0; i < threads.size(); ++i) {
+        for (size_t j = i + 1; j < threads.size(); ++j) {
+            EXPECT_NE(threads[i], threads[j]);
+        }
+    }
+}
+
+TEST(WorkerPoolTest, SubmitAnySpreadsAcrossShards) {
+    WorkerPool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    
+    for (size_t i = 0; i < pool.size(); ++i) {
+        pool.submit_any([&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            }
+            released.wait();
+        });
+    }
+    release.set_value();
+    pool.stop();
+    EXPECT_EQ(threads.size(), pool.size());
+}
+
+}
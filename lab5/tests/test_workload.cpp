@@ -0,0 +1,70 @@
+#include "workload.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace EmployeeSystem {
+
+TEST(KeyChooserTest, UniformKeysStayInRange) {
+    KeyChooser chooser(50, KeyDistribution::UNIFORM, KeyChooser::DEFAULT_THETA, 7);
+    std::vector<int> seen(51, 0);
+    for (int i = 0; i < 10000; ++i) {
+        int32_t key = chooser.next();
+        ASSERT_GE(key, 1);
+        ASSERT_LE(key, 50);
+        ++seen[key];
+    }
+    for (int key = 1; key <= 50; ++key) {
+        EXPECT_GT(seen[key], 0);
+    }
+}
+
+TEST(KeyChooserTest, ZipfianFavoursLowKeys) {
+    KeyChooser chooser(1000, KeyDistribution::ZIPFIAN, 0.99, 11);
+    std::vector<int> seen(1001, 0);
+    for (int i = 0; i < 50000; ++i) {
+        int32_t key = chooser.next();
+        ASSERT_GE(key, 1);
+        ASSERT_LE(key, 1000);
+        ++seen[key];
+    }
+    for (int key = 2; key <= 1000; ++key) {
+        EXPECT_GE(seen[1], seen[key]);
+    }
+    int tail = 0;
+    for (int key = 501; key <= 1000; ++key) {
+        tail += seen[key];
+    }
+    EXPECT_GT(seen[1] + seen[2] + seen[3], tail);
+}
+
+TEST(OperationMixTest, ParsesAndPicksInProportion) {
+    OperationMix mix;
+    ASSERT_TRUE(mix.parse("50:50:0"));
+    EXPECT_EQ(mix.read, 50u);
+    EXPECT_EQ(mix.write, 50u);
+    EXPECT_EQ(mix.lock, 0u);
+
+    std::mt19937_64 rng(3);
+    int counts[3] = {0, 0, 0};
+    for (int i = 0; i < 10000; ++i) {
+        ++counts[static_cast<int>(mix.pick(rng))];
+    }
+    EXPECT_EQ(counts[static_cast<int>(WorkloadOp::LOCK)], 0);
+    EXPECT_NEAR(counts[static_cast<int>(WorkloadOp::READ)], 5000, 300);
+
+    EXPECT_FALSE(mix.parse("0:0:0"));
+    EXPECT_FALSE(mix.parse("80"));
+    EXPECT_EQ(mix.read, 50u);
+    EXPECT_STREQ(OperationMix::name(WorkloadOp::WRITE), "write");
+}
+
+TEST(OperationMixTest, ParsesDistributionNames) {
+    KeyDistribution distribution = KeyDistribution::UNIFORM;
+    EXPECT_TRUE(parse_distribution("zipf", distribution));
+    EXPECT_EQ(distribution, KeyDistribution::ZIPFIAN);
+    EXPECT_TRUE(parse_distribution("uniform", distribution));
+    EXPECT_EQ(distribution, KeyDistribution::UNIFORM);
+    EXPECT_FALSE(parse_distribution("gaussian", distribution));
+}
+
+}
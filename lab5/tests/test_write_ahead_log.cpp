@@ -0,0 +1,114 @@
+#include "write_ahead_log.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace EmployeeSystem {
+
+class WriteAheadLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        wal_path_ = "test_employees.wal";
+        std::filesystem::remove(wal_path_);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(wal_path_);
+    }
+    
+    std::vector<std::pair<uint64_t, Employee>> Replay() {
+        std::vector<std::pair<uint64_t, Employee>> records;
+        WriteAheadLog reader(wal_path_);
+        reader.replay([&records](uint64_t slot, const Employee& emp) {
+            records.emplace_back(slot, emp);
+            return true;
+        });
+        return records;
+    }
+    
+    std::string wal_path_;
+};
+
+TEST_F(WriteAheadLogTest, AppendSyncAndReplay) {
+    WriteAheadLog wal(wal_path_);
+    ASSERT_TRUE(wal.open());
+    
+    uint64_t first = wal.append(0, Employee(1, "Alice", 10.0));
+    uint64_t second = wal.append(5, Employee(2, "Bob", 20.0));
+    EXPECT_LT(first, second);
+    EXPECT_TRUE(wal.sync(second));
+    EXPECT_EQ(wal.logged_records(), 2);
+    
+    auto records = Replay();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].first, 0);
+    EXPECT_TRUE(records[0].second == Employee(1, "Alice", 10.0));
+    EXPECT_EQ(records[1].first, 5);
+    EXPECT_TRUE(records[1].second == Employee(2, "Bob", 20.0));
+}
+
+TEST_F(WriteAheadLogTest, ResetTruncatesLog) {
+    WriteAheadLog wal(wal_path_);
+    ASSERT_TRUE(wal.open());
+    
+    wal.append(0, Employee(1, "Alice", 10.0));
+    ASSERT_TRUE(wal.flush());
+    EXPECT_TRUE(wal.reset());
+    
+    EXPECT_EQ(wal.logged_records(), 0);
+    EXPECT_EQ(std::filesystem::file_size(wal_path_), 0);
+    EXPECT_TRUE(Replay().empty());
+}
+
+TEST_F(WriteAheadLogTest, TornTailIsIgnored) {
+    {
+        WriteAheadLog wal(wal_path_);
+        ASSERT_TRUE(wal.open());
+        wal.append(0, Employee(1, "Alice", 10.0));
+        wal.append(1, Employee(2, "Bob", 20.0));
+        ASSERT_TRUE(wal.flush());
+    }
+    
+    std::filesystem::resize_file(wal_path_, sizeof(WalRecord) + sizeof(WalRecord) / 2);
+    EXPECT_EQ(Replay().size(), 1);
+    
+    {
+        std::fstream file(wal_path_, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(uint64_t));
+        file.put('\x7f');
+    }
+    EXPECT_TRUE(Replay().empty());
+}
+
+TEST_F(WriteAheadLogTest, GroupCommitSharesSyncs) {
+    WriteAheadLog wal(wal_path_);
+    ASSERT_TRUE(wal.open());
+    
+    constexpr int NUM_THREADS = 8;
+    constexpr int NUM_WRITES = 50;
+    
+    std::vector<std::thread> threads;
+    std::atomic<int> committed{0};
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&wal, &committed, t]() {
+            for (int i = 0; i < NUM_WRITES; ++i) {
+                uint64_t seq = wal.append(t, Employee(t + 1, "Worker", i));
+                if (wal.sync(seq)) {
+                    committed++;
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(committed, NUM_THREADS * NUM_WRITES);
+    EXPECT_LE(wal.sync_count(), static_cast<size_t>(NUM_THREADS * NUM_WRITES));
+    EXPECT_EQ(Replay().size(), static_cast<size_t>(NUM_THREADS * NUM_WRITES));
+}
+
+}